@@ -0,0 +1,233 @@
+/*
+ Detective Quest - Comparação de benchmarks
+
+ Compara os resultados de uma execução da suíte (trabalhoDetectiveQuest --bench
+ <arquivo>) com uma execução de referência (baseline). Para cada benchmark
+ calcula a variação da média e aplica o teste t de Welch; uma regressão é
+ sinalizada quando a média piora além do limiar e a diferença é significativa.
+
+ Uso:
+   comparar_bench <baseline> <novo> [limiar%]      (padrão: 5%)
+   comparar_bench --atualizar <baseline> <novo>     grava <novo> como baseline
+                                                   se não houver regressões
+ Compilar: gcc -std=c11 -O2 comparar_bench.c -o comparar_bench -lm
+ Código de saída: 0 sem regressões, 1 com regressões, 2 em caso de erro.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MAX_BENCHMARKS 64
+#define MAX_AMOSTRAS 256
+#define MAX_LINHA 8192
+#define NIVEL_SIGNIFICANCIA 0.05
+#define PREFIXO_BACKENDS "# backends: "
+
+typedef struct Resultado {
+    char nome[64];
+    double amostras[MAX_AMOSTRAS];
+    int n;
+} Resultado;
+
+typedef struct Execucao {
+    Resultado resultados[MAX_BENCHMARKS];
+    int total;
+    char backends[256];   // linha "# backends:" da execução (vazia se ausente)
+} Execucao;
+
+/* ----------------------------- Leitura ----------------------------- */
+
+/**
+ * lerExecucao()
+ * Lê um arquivo de resultados: uma linha por benchmark com o nome seguido das
+ * amostras em ns/op. Linhas iniciadas por '#' são comentários, exceto
+ * "# backends:", guardada para a comparação.
+ * Retorna 0 em caso de sucesso e -1 em caso de erro.
+ */
+int lerExecucao(const char *caminho, Execucao *e) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) { perror(caminho); return -1; }
+    char linha[MAX_LINHA];
+    e->total = 0;
+    e->backends[0] = '\0';
+    while (fgets(linha, sizeof(linha), f)) {
+        if (strncmp(linha, PREFIXO_BACKENDS, strlen(PREFIXO_BACKENDS)) == 0) {
+            snprintf(e->backends, sizeof(e->backends), "%.*s", (int)sizeof(e->backends) - 1, linha + strlen(PREFIXO_BACKENDS));
+            e->backends[strcspn(e->backends, "\n")] = '\0';
+            continue;
+        }
+        if (linha[0] == '#' || linha[0] == '\n') continue;
+        if (e->total == MAX_BENCHMARKS) break;
+        Resultado *r = &e->resultados[e->total];
+        char *tok = strtok(linha, " \t\n");
+        if (!tok) continue;
+        snprintf(r->nome, sizeof(r->nome), "%s", tok);
+        r->n = 0;
+        while ((tok = strtok(NULL, " \t\n")) && r->n < MAX_AMOSTRAS) r->amostras[r->n++] = atof(tok);
+        if (r->n > 0) e->total++;
+    }
+    fclose(f);
+    return 0;
+}
+
+const Resultado *buscarResultado(const Execucao *e, const char *nome) {
+    for (int i = 0; i < e->total; i++)
+        if (strcmp(e->resultados[i].nome, nome) == 0) return &e->resultados[i];
+    return NULL;
+}
+
+/* ----------------------------- Estatística ----------------------------- */
+
+void mediaVariancia(const Resultado *r, double *media, double *var) {
+    double soma = 0, soma2 = 0;
+    for (int i = 0; i < r->n; i++) soma += r->amostras[i];
+    *media = soma / r->n;
+    for (int i = 0; i < r->n; i++) soma2 += (r->amostras[i] - *media) * (r->amostras[i] - *media);
+    *var = r->n > 1 ? soma2 / (r->n - 1) : 0;
+}
+
+// Fração contínua da função beta incompleta (Lentz modificado)
+double fracaoBeta(double a, double b, double x) {
+    const double minimo = 1e-300;
+    double c = 1, d = 1 - (a + b) * x / (a + 1);
+    if (fabs(d) < minimo) d = minimo;
+    d = 1 / d;
+    double h = d;
+    for (int m = 1; m <= 300; m++) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1) * (a + m2));
+        d = 1 + aa * d; if (fabs(d) < minimo) d = minimo;
+        c = 1 + aa / c; if (fabs(c) < minimo) c = minimo;
+        d = 1 / d;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1));
+        d = 1 + aa * d; if (fabs(d) < minimo) d = minimo;
+        c = 1 + aa / c; if (fabs(c) < minimo) c = minimo;
+        d = 1 / d;
+        double delta = d * c;
+        h *= delta;
+        if (fabs(delta - 1) < 1e-12) break;
+    }
+    return h;
+}
+
+// Função beta incompleta regularizada I_x(a, b)
+double betaIncompleta(double a, double b, double x) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    double ln = lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1 - x);
+    if (x < (a + 1) / (a + b + 2)) return exp(ln) * fracaoBeta(a, b, x) / a;
+    return 1 - exp(ln) * fracaoBeta(b, a, 1 - x) / b;
+}
+
+/**
+ * testeWelch()
+ * Teste t de Welch para médias com variâncias diferentes. Retorna o p-valor
+ * bilateral. Com menos de duas amostras em um dos lados não há variância para
+ * estimar e o resultado é 1 (nada a concluir); sem variação nos dois lados,
+ * qualquer diferença de média é significativa.
+ */
+double testeWelch(const Resultado *a, const Resultado *b) {
+    if (a->n < 2 || b->n < 2) return 1.0;
+    double ma, va, mb, vb;
+    mediaVariancia(a, &ma, &va);
+    mediaVariancia(b, &mb, &vb);
+    double sa = va / a->n, sb = vb / b->n;
+    if (sa + sb == 0) return ma == mb ? 1.0 : 0.0;
+    double t = (mb - ma) / sqrt(sa + sb);
+    double gl = (sa + sb) * (sa + sb) / (sa * sa / (a->n - 1) + sb * sb / (b->n - 1));
+    return betaIncompleta(gl / 2, 0.5, gl / (gl + t * t));
+}
+
+/* ----------------------------- Comparação ----------------------------- */
+
+// Largura da coluna de nomes: o maior nome das duas execuções
+int larguraNomes(const Execucao *base, const Execucao *novo) {
+    int largura = (int)strlen("benchmark");
+    for (int i = 0; i < base->total; i++)
+        if ((int)strlen(base->resultados[i].nome) > largura) largura = (int)strlen(base->resultados[i].nome);
+    for (int i = 0; i < novo->total; i++)
+        if ((int)strlen(novo->resultados[i].nome) > largura) largura = (int)strlen(novo->resultados[i].nome);
+    return largura;
+}
+
+/**
+ * comparar()
+ * Exibe a tabela de comparação e retorna o número de regressões.
+ */
+int comparar(const Execucao *base, const Execucao *novo, double limiar) {
+    int regressoes = 0;
+    int w = larguraNomes(base, novo);
+    printf("%-*s %12s %12s %10s %9s  %s\n", w, "benchmark", "base ns/op", "novo ns/op", "variação", "p", "situação");
+    for (int i = 0; i < novo->total; i++) {
+        const Resultado *rn = &novo->resultados[i];
+        const Resultado *rb = buscarResultado(base, rn->nome);
+        double mn, vn;
+        mediaVariancia(rn, &mn, &vn);
+        if (!rb) {
+            printf("%-*s %12s %12.2f %9s %9s  novo\n", w, rn->nome, "-", mn, "-", "-");
+            continue;
+        }
+        double mb, vb;
+        mediaVariancia(rb, &mb, &vb);
+        double variacao = mb > 0 ? (mn - mb) / mb * 100 : 0;
+        double p = testeWelch(rb, rn);
+        const char *situacao = "igual";
+        if (p < NIVEL_SIGNIFICANCIA && variacao > limiar) { situacao = "REGRESSÃO"; regressoes++; }
+        else if (p < NIVEL_SIGNIFICANCIA && variacao < -limiar) situacao = "melhora";
+        printf("%-*s %12.2f %12.2f %+8.1f%% %9.4f  %s\n", w, rn->nome, mb, mn, variacao, p, situacao);
+    }
+    for (int i = 0; i < base->total; i++)
+        if (!buscarResultado(novo, base->resultados[i].nome))
+            printf("%-*s ausente na nova execução\n", w, base->resultados[i].nome);
+    return regressoes;
+}
+
+// Copia o arquivo de resultados para o baseline
+int copiarArquivo(const char *origem, const char *destino) {
+    FILE *in = fopen(origem, "rb");
+    if (!in) { perror(origem); return -1; }
+    FILE *out = fopen(destino, "wb");
+    if (!out) { perror(destino); fclose(in); return -1; }
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) fwrite(buf, 1, n, out);
+    fclose(in);
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+/* ----------------------------- main ----------------------------- */
+int main(int argc, char **argv) {
+    int atualizar = argc > 1 && strcmp(argv[1], "--atualizar") == 0;
+    int a = atualizar ? 2 : 1;
+    if (argc - a < 2) {
+        fprintf(stderr, "Uso: %s [--atualizar] <baseline> <novo> [limiar%%]\n", argv[0]);
+        return 2;
+    }
+    double limiar = argc - a > 2 ? atof(argv[a + 2]) : 5.0;
+
+    static Execucao base, novo;
+    if (lerExecucao(argv[a + 1], &novo) != 0) return 2;
+    if (lerExecucao(argv[a], &base) != 0) {
+        if (!atualizar) return 2;
+        // sem baseline: a nova execução passa a ser a referência
+        printf("Baseline inexistente; gravando %s como referência.\n", argv[a + 1]);
+        return copiarArquivo(argv[a + 1], argv[a]) == 0 ? 0 : 2;
+    }
+
+    // backends diferentes mudam o que está sendo comparado
+    if (base.backends[0] || novo.backends[0]) {
+        printf("Backends da base: %s\n", base.backends[0] ? base.backends : "?");
+        printf("Backends do novo: %s%s\n\n", novo.backends[0] ? novo.backends : "?",
+               strcmp(base.backends, novo.backends) != 0 ? "  (DIFERENTES)" : "");
+    }
+    int regressoes = comparar(&base, &novo, limiar);
+    printf("\n%d regressão(ões) acima de %.1f%% (p < %.2f).\n", regressoes, limiar, NIVEL_SIGNIFICANCIA);
+    if (atualizar && regressoes == 0) {
+        if (copiarArquivo(argv[a + 1], argv[a]) != 0) return 2;
+        printf("Baseline atualizado.\n");
+    }
+    return regressoes > 0 ? 1 : 0;
+}
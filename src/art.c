@@ -0,0 +1,325 @@
+#include "detective.h"
+
+/* ----------------------------- Árvore radix adaptativa ----------------------------- */
+
+int ehFolhaArt(const NoArt *n) {
+    return ((uintptr_t)n & 1) != 0;
+}
+
+FolhaArt *folhaArt(const NoArt *n) {
+    return (FolhaArt*)((uintptr_t)n & ~(uintptr_t)1);
+}
+
+static NoArt *criarFolhaArt(const uint8_t *chave, size_t tamanho) {
+    FolhaArt *f = malloc(sizeof(FolhaArt) + tamanho);
+    if (!f) { perror("malloc"); exit(EXIT_FAILURE); }
+    f->tamanho = (uint32_t)tamanho;
+    memcpy(f->chave, chave, tamanho);
+    return (NoArt*)((uintptr_t)f | 1);
+}
+
+const size_t TAMANHO_NO_ART[] = {
+    sizeof(NoArt4), sizeof(NoArt16), sizeof(NoArt48), sizeof(NoArt256)
+};
+
+static NoArt *criarNoArt(int tipo) {
+    NoArt *n = calloc(1, TAMANHO_NO_ART[tipo]);
+    if (!n) { perror("calloc"); exit(EXIT_FAILURE); }
+    n->tipo = (uint8_t)tipo;
+    return n;
+}
+
+static size_t menor(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+// Posição do filho com o byte `c` em um nó de 16 filhos (-1 se ausente)
+static int posicaoNo16(const NoArt16 *n, uint8_t c) {
+#ifdef __SSE2__
+    __m128i iguais = _mm_cmpeq_epi8(_mm_set1_epi8((char)c),
+                                    _mm_loadu_si128((const __m128i*)n->chaves));
+    unsigned mascara = (unsigned)_mm_movemask_epi8(iguais) & ((1u << n->h.nFilhos) - 1);
+    return mascara ? __builtin_ctz(mascara) : -1;
+#else
+    for (int i = 0; i < n->h.nFilhos; i++)
+        if (n->chaves[i] == c) return i;
+    return -1;
+#endif
+}
+
+// Endereço do ponteiro para o filho com o byte `c`, ou NULL se não existir
+static NoArt **buscarFilhoArt(NoArt *n, uint8_t c) {
+    switch (n->tipo) {
+    case ART_NO4: {
+        NoArt4 *n4 = (NoArt4*)n;
+        for (int i = 0; i < n->nFilhos; i++)
+            if (n4->chaves[i] == c) return &n4->filhos[i];
+        return NULL;
+    }
+    case ART_NO16: {
+        int i = posicaoNo16((NoArt16*)n, c);
+        return i >= 0 ? &((NoArt16*)n)->filhos[i] : NULL;
+    }
+    case ART_NO48: {
+        NoArt48 *n48 = (NoArt48*)n;
+        return n48->indice[c] ? &n48->filhos[n48->indice[c] - 1] : NULL;
+    }
+    default: {
+        NoArt256 *n256 = (NoArt256*)n;
+        return n256->filhos[c] ? &n256->filhos[c] : NULL;
+    }
+    }
+}
+
+// Folha de menor chave abaixo de `n` (usada para recuperar prefixos longos)
+static FolhaArt *minimoArt(const NoArt *n) {
+    while (!ehFolhaArt(n)) {
+        switch (n->tipo) {
+        case ART_NO4:  n = ((const NoArt4*)n)->filhos[0]; break;
+        case ART_NO16: n = ((const NoArt16*)n)->filhos[0]; break;
+        case ART_NO48: {
+            const NoArt48 *n48 = (const NoArt48*)n;
+            int c = 0;
+            while (!n48->indice[c]) c++;
+            n = n48->filhos[n48->indice[c] - 1];
+            break;
+        }
+        default: {
+            const NoArt256 *n256 = (const NoArt256*)n;
+            int c = 0;
+            while (!n256->filhos[c]) c++;
+            n = n256->filhos[c];
+            break;
+        }
+        }
+    }
+    return folhaArt(n);
+}
+
+// Acrescenta um filho em ordem, trocando o nó por um maior quando está cheio
+static void adicionarFilhoArt(NoArt **ref, uint8_t c, NoArt *filho) {
+    NoArt *n = *ref;
+    switch (n->tipo) {
+    case ART_NO4:
+    case ART_NO16: {
+        int cap = n->tipo == ART_NO4 ? 4 : 16;
+        uint8_t *chaves = n->tipo == ART_NO4 ? ((NoArt4*)n)->chaves : ((NoArt16*)n)->chaves;
+        NoArt **filhos = n->tipo == ART_NO4 ? ((NoArt4*)n)->filhos : ((NoArt16*)n)->filhos;
+        if (n->nFilhos < cap) {
+            int i = 0;
+            while (i < n->nFilhos && chaves[i] < c) i++;
+            memmove(chaves + i + 1, chaves + i, n->nFilhos - i);
+            memmove(filhos + i + 1, filhos + i, (n->nFilhos - i) * sizeof(NoArt*));
+            chaves[i] = c;
+            filhos[i] = filho;
+            n->nFilhos++;
+            return;
+        }
+        NoArt *maior = criarNoArt(n->tipo + 1);
+        memcpy(maior, n, sizeof(NoArt));
+        maior->tipo = (uint8_t)(n->tipo + 1);
+        if (maior->tipo == ART_NO16) {
+            memcpy(((NoArt16*)maior)->chaves, chaves, cap);
+            memcpy(((NoArt16*)maior)->filhos, filhos, cap * sizeof(NoArt*));
+        } else {
+            NoArt48 *n48 = (NoArt48*)maior;
+            for (int i = 0; i < cap; i++) {
+                n48->indice[chaves[i]] = (uint8_t)(i + 1);
+                n48->filhos[i] = filhos[i];
+            }
+        }
+        free(n);
+        *ref = maior;
+        adicionarFilhoArt(ref, c, filho);
+        return;
+    }
+    case ART_NO48: {
+        NoArt48 *n48 = (NoArt48*)n;
+        if (n->nFilhos < 48) {
+            int pos = 0;
+            while (n48->filhos[pos]) pos++;
+            n48->filhos[pos] = filho;
+            n48->indice[c] = (uint8_t)(pos + 1);
+            n->nFilhos++;
+            return;
+        }
+        NoArt256 *n256 = (NoArt256*)criarNoArt(ART_NO256);
+        memcpy(n256, n, sizeof(NoArt));
+        n256->h.tipo = ART_NO256;
+        for (int b = 0; b < 256; b++)
+            if (n48->indice[b]) n256->filhos[b] = n48->filhos[n48->indice[b] - 1];
+        free(n);
+        *ref = (NoArt*)n256;
+        adicionarFilhoArt(ref, c, filho);
+        return;
+    }
+    default:
+        ((NoArt256*)n)->filhos[c] = filho;
+        n->nFilhos++;
+    }
+}
+
+// Quantos bytes do prefixo de `n` coincidem com a chave a partir de `prof`
+static size_t prefixoComumArt(const NoArt *n, const uint8_t *chave, size_t tam, size_t prof) {
+    size_t limite = menor(menor(n->tamPrefixo, ART_PREFIXO_MAX), tam - prof);
+    size_t i = 0;
+    while (i < limite && n->prefixo[i] == chave[prof + i]) i++;
+    if (i < ART_PREFIXO_MAX || n->tamPrefixo <= ART_PREFIXO_MAX) return i;
+    // prefixo maior que o armazenado: o restante é lido de uma folha qualquer
+    const FolhaArt *f = minimoArt(n);
+    limite = menor(n->tamPrefixo, menor(f->tamanho, tam) - prof);
+    while (i < limite && (uint8_t)f->chave[prof + i] == chave[prof + i]) i++;
+    return i;
+}
+
+static int inserirNoArt(NoArt **ref, const uint8_t *chave, size_t tam, size_t prof) {
+    NoArt *n = *ref;
+    if (!n) {
+        *ref = criarFolhaArt(chave, tam);
+        return 1;
+    }
+    if (ehFolhaArt(n)) {
+        const FolhaArt *f = folhaArt(n);
+        if (f->tamanho == tam && memcmp(f->chave, chave, tam) == 0) return 0;
+        // duas chaves distintas: nó de 4 filhos com o trecho comum como prefixo
+        size_t comum = 0;
+        while ((uint8_t)f->chave[prof + comum] == chave[prof + comum]) comum++;
+        NoArt *novo = criarNoArt(ART_NO4);
+        novo->tamPrefixo = (uint32_t)comum;
+        memcpy(novo->prefixo, chave + prof, menor(comum, ART_PREFIXO_MAX));
+        adicionarFilhoArt(&novo, (uint8_t)f->chave[prof + comum], n);
+        adicionarFilhoArt(&novo, chave[prof + comum], criarFolhaArt(chave, tam));
+        *ref = novo;
+        return 1;
+    }
+    if (n->tamPrefixo) {
+        size_t comum = prefixoComumArt(n, chave, tam, prof);
+        if (comum < n->tamPrefixo) {
+            // a chave diverge dentro do prefixo: divide o nó nesse ponto
+            NoArt *novo = criarNoArt(ART_NO4);
+            novo->tamPrefixo = (uint32_t)comum;
+            memcpy(novo->prefixo, n->prefixo, menor(comum, ART_PREFIXO_MAX));
+            uint8_t divergente;
+            if (n->tamPrefixo <= ART_PREFIXO_MAX) {
+                divergente = n->prefixo[comum];
+                n->tamPrefixo -= (uint32_t)comum + 1;
+                memmove(n->prefixo, n->prefixo + comum + 1, n->tamPrefixo);
+            } else {
+                const FolhaArt *f = minimoArt(n);
+                divergente = (uint8_t)f->chave[prof + comum];
+                n->tamPrefixo -= (uint32_t)comum + 1;
+                memcpy(n->prefixo, f->chave + prof + comum + 1, menor(n->tamPrefixo, ART_PREFIXO_MAX));
+            }
+            adicionarFilhoArt(&novo, divergente, n);
+            adicionarFilhoArt(&novo, chave[prof + comum], criarFolhaArt(chave, tam));
+            *ref = novo;
+            return 1;
+        }
+        prof += n->tamPrefixo;
+    }
+    NoArt **filho = buscarFilhoArt(n, chave[prof]);
+    if (filho) return inserirNoArt(filho, chave, tam, prof + 1);
+    adicionarFilhoArt(ref, chave[prof], criarFolhaArt(chave, tam));
+    return 1;
+}
+
+/**
+ * inserirNaRadix()
+ * Insere uma pista na ART, ignorando duplicatas. Retorna 1 se a pista era nova.
+ */
+int inserirNaRadix(ArvoreRadix *a, const char *pista) {
+    int nova = inserirNoArt(&a->raiz, (const uint8_t*)pista, strlen(pista) + 1, 0);
+    a->total += nova;
+    return nova;
+}
+
+/**
+ * buscarNaRadix()
+ * Retorna 1 se a pista está na ART. O custo depende do tamanho da pista, não
+ * do número de pistas: cada byte é examinado uma única vez no caminho e a
+ * folha confirma a parte dos prefixos que não cabe nos nós.
+ */
+int buscarNaRadix(const ArvoreRadix *a, const char *pista) {
+    const uint8_t *chave = (const uint8_t*)pista;
+    size_t tam = strlen(pista) + 1, prof = 0;
+    NoArt *n = a->raiz;
+    while (n) {
+        if (ehFolhaArt(n)) {
+            const FolhaArt *f = folhaArt(n);
+            return f->tamanho == tam && memcmp(f->chave, chave, tam) == 0;
+        }
+        if (n->tamPrefixo) {
+            if (prof + n->tamPrefixo >= tam) return 0;
+            size_t armazenado = menor(n->tamPrefixo, ART_PREFIXO_MAX);
+            if (memcmp(n->prefixo, chave + prof, armazenado) != 0) return 0;
+            prof += n->tamPrefixo;
+        }
+        NoArt **filho = buscarFilhoArt(n, chave[prof++]);
+        n = filho ? *filho : NULL;
+    }
+    return 0;
+}
+
+/**
+ * percorrerRadix()
+ * Visita as pistas em ordem lexicográfica (mesma ordem de strcmp).
+ */
+void percorrerRadix(const NoArt *n, void (*visitar)(const char *pista, void *ctx), void *ctx) {
+    if (!n) return;
+    if (ehFolhaArt(n)) {
+        visitar(folhaArt(n)->chave, ctx);
+        return;
+    }
+    switch (n->tipo) {
+    case ART_NO4:
+        for (int i = 0; i < n->nFilhos; i++) percorrerRadix(((const NoArt4*)n)->filhos[i], visitar, ctx);
+        break;
+    case ART_NO16:
+        for (int i = 0; i < n->nFilhos; i++) percorrerRadix(((const NoArt16*)n)->filhos[i], visitar, ctx);
+        break;
+    case ART_NO48: {
+        const NoArt48 *n48 = (const NoArt48*)n;
+        for (int c = 0; c < 256; c++)
+            if (n48->indice[c]) percorrerRadix(n48->filhos[n48->indice[c] - 1], visitar, ctx);
+        break;
+    }
+    default:
+        for (int c = 0; c < 256; c++) percorrerRadix(((const NoArt256*)n)->filhos[c], visitar, ctx);
+    }
+}
+
+// Endereços dos filhos de um nó interno (em ordem de armazenamento)
+NoArt **filhosArt(NoArt *n, int *quantidade) {
+    switch (n->tipo) {
+    case ART_NO4:  *quantidade = 4;   return ((NoArt4*)n)->filhos;
+    case ART_NO16: *quantidade = 16;  return ((NoArt16*)n)->filhos;
+    case ART_NO48: *quantidade = 48;  return ((NoArt48*)n)->filhos;
+    default:       *quantidade = 256; return ((NoArt256*)n)->filhos;
+    }
+}
+
+NoArt *clonarRadix(const NoArt *n) {
+    if (!n) return NULL;
+    if (ehFolhaArt(n)) {
+        const FolhaArt *f = folhaArt(n);
+        return criarFolhaArt((const uint8_t*)f->chave, f->tamanho);
+    }
+    NoArt *copia = criarNoArt(n->tipo);
+    memcpy(copia, n, TAMANHO_NO_ART[n->tipo]);
+    int q;
+    NoArt **filhos = filhosArt(copia, &q);
+    for (int i = 0; i < q; i++) filhos[i] = clonarRadix(filhos[i]);
+    return copia;
+}
+
+void liberarRadix(NoArt *n) {
+    if (!n) return;
+    if (ehFolhaArt(n)) {
+        free(folhaArt(n));
+        return;
+    }
+    int q;
+    NoArt **filhos = filhosArt(n, &q);
+    for (int i = 0; i < q; i++) liberarRadix(filhos[i]);
+    free(n);
+}
@@ -0,0 +1,19 @@
+#include "detective.h"
+
+/* ----------------------------- Auxiliares ----------------------------- */
+
+// Duplicador seguro de string
+char *strdup_safe(const char *s) {
+    if (!s) return NULL;
+    char *dup = malloc(strlen(s) + 1);
+    if (!dup) { perror("malloc"); exit(EXIT_FAILURE); }
+    strcpy(dup, s);
+    return dup;
+}
+
+// Relógio monotônico em nanossegundos
+double agoraNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
@@ -0,0 +1,79 @@
+#include "detective.h"
+
+/* ----------------------------- Registro de backends ----------------------------- */
+
+static const OpcaoBackend OPCOES_CADERNO[] = {
+    { "bst", INDICE_BST }, { "art", INDICE_ART }, { "saltos", INDICE_SALTOS },
+};
+static const OpcaoBackend OPCOES_TABELA[] = {
+    { "encadeada", TABELA_ENCADEADA }, { "ordenada", TABELA_ORDENADA },
+};
+static const OpcaoBackend OPCOES_NOS[] = {
+    { "pool", NOS_POOL }, { "malloc", NOS_MALLOC },
+};
+
+// A primeira opção de cada família é o padrão
+static const FamiliaBackend BACKENDS[] = {
+    { "caderno", "índice de pistas dos cadernos", OPCOES_CADERNO, N_ELEMENTOS(OPCOES_CADERNO), &indicePistasPadrao },
+    { "tabela", "cadeias da tabela pista -> suspeito", OPCOES_TABELA, N_ELEMENTOS(OPCOES_TABELA), &tabelaPistasPadrao },
+    { "nos", "alocação das salas e entradas da hash", OPCOES_NOS, N_ELEMENTOS(OPCOES_NOS), &disposicaoNos },
+};
+
+const FamiliaBackend *buscarFamiliaBackend(const char *nome) {
+    for (int i = 0; i < N_ELEMENTOS(BACKENDS); i++)
+        if (strcmp(BACKENDS[i].nome, nome) == 0) return &BACKENDS[i];
+    return NULL;
+}
+
+// Nome da opção em uso na família
+const char *backendEmUso(const FamiliaBackend *f) {
+    for (int i = 0; i < f->nOpcoes; i++)
+        if (f->opcoes[i].valor == *f->escolha) return f->opcoes[i].nome;
+    return "?";
+}
+
+// Opção em uso de cada família, como "família=nome" separados por espaço
+void escreverBackendsEmUso(FILE *out) {
+    for (int i = 0; i < N_ELEMENTOS(BACKENDS); i++)
+        fprintf(out, "%s%s=%s", i ? " " : "", BACKENDS[i].nome, backendEmUso(&BACKENDS[i]));
+}
+
+void listarBackends(FILE *out) {
+    for (int i = 0; i < N_ELEMENTOS(BACKENDS); i++) {
+        const FamiliaBackend *f = &BACKENDS[i];
+        fprintf(out, "%-8s %s%*s", f->nome, f->descricao, 40 - larguraUtf8(f->descricao), "");
+        for (int o = 0; o < f->nOpcoes; o++)
+            fprintf(out, " %s%s", f->opcoes[o].nome, f->opcoes[o].valor == *f->escolha ? "*" : "");
+        fprintf(out, "\n");
+    }
+}
+
+/**
+ * selecionarBackend()
+ * Escolhe uma opção a partir de "família=nome" (ex.: "caderno=art"). Deve ser
+ * chamada antes de carregar os casos: vale para as estruturas criadas depois.
+ * Retorna 0 em caso de sucesso ou -1 (com mensagem) se o nome for desconhecido.
+ */
+int selecionarBackend(const char *especificacao) {
+    const char *igual = strchr(especificacao, '=');
+    char familia[32];
+    size_t n = igual ? (size_t)(igual - especificacao) : 0;
+    if (!igual || n >= sizeof(familia)) {
+        fprintf(stderr, "Backend deve ser <família>=<nome>: %s\n", especificacao);
+        return -1;
+    }
+    memcpy(familia, especificacao, n);
+    familia[n] = '\0';
+    const FamiliaBackend *f = buscarFamiliaBackend(familia);
+    if (f) {
+        for (int o = 0; o < f->nOpcoes; o++) {
+            if (strcmp(f->opcoes[o].nome, igual + 1) == 0) {
+                *f->escolha = f->opcoes[o].valor;
+                return 0;
+            }
+        }
+    }
+    fprintf(stderr, "Backend desconhecido: %s\nDisponíveis:\n", especificacao);
+    listarBackends(stderr);
+    return -1;
+}
@@ -0,0 +1,587 @@
+#include "detective.h"
+
+/* ----------------------------- Benchmarks ----------------------------- */
+
+#define BENCH_AMOSTRAS 15
+#define BENCH_PISTAS 2000
+#define BENCH_CONSULTAS 200000
+
+// Gerador xorshift64*: sequência reprodutível entre execuções
+uint64_t proximoAleatorio(uint64_t *estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return *estado * 2685821657736338717ull;
+}
+
+// Evita que o compilador descarte resultados dos laços medidos
+volatile uintptr_t benchSumidouro;
+
+static char chavesBench[BENCH_PISTAS][40];
+
+// Chaves aleatórias com prefixo comum longo, como as frases das pistas
+void gerarChavesBench(uint64_t *semente) {
+    for (int i = 0; i < BENCH_PISTAS; i++)
+        snprintf(chavesBench[i], sizeof(chavesBench[i]), "Pista encontrada %016llx",
+                 (unsigned long long)proximoAleatorio(semente));
+}
+
+// ns por encontrarSuspeito() numa tabela com metade das chaves (metade das consultas falha)
+double benchConsultaHash(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    gerarChavesBench(semente);
+    TabelaPistas tabela;
+    inicializarTabelaPistas(&tabela, tabelaPistasPadrao);
+    for (int i = 0; i < BENCH_PISTAS / 2; i++) inserirNaHash(&tabela, chavesBench[i], chavesBench[i]);
+    uintptr_t acc = 0;
+    double t0 = agoraNs();
+    for (int i = 0; i < BENCH_CONSULTAS; i++)
+        acc += (uintptr_t)encontrarSuspeito(&tabela, chavesBench[proximoAleatorio(semente) % BENCH_PISTAS]);
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    freeHash(&tabela);
+    return t / BENCH_CONSULTAS;
+}
+
+// ns por pista inserida no índice de um caderno novo, com chaves aleatórias
+double benchInsercaoCaderno(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    gerarChavesBench(semente);
+    Caderno *c = criarCaderno();
+    double t0 = agoraNs();
+    for (int i = 0; i < BENCH_PISTAS; i++) inserirNoIndiceDePistas(c, chavesBench[i]);
+    double t = agoraNs() - t0;
+    liberarCaderno(c);
+    return t / BENCH_PISTAS;
+}
+
+// ns por cadernoContemPista() em um caderno de BENCH_PISTAS chaves
+double benchBuscaCaderno(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    gerarChavesBench(semente);
+    Caderno *c = criarCaderno();
+    for (int i = 0; i < BENCH_PISTAS; i++) inserirNoIndiceDePistas(c, chavesBench[i]);
+    uintptr_t acc = 0;
+    double t0 = agoraNs();
+    for (int i = 0; i < BENCH_CONSULTAS; i++)
+        acc += cadernoContemPista(c, chavesBench[proximoAleatorio(semente) % BENCH_PISTAS]);
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    liberarCaderno(c);
+    return t / BENCH_CONSULTAS;
+}
+
+#define BENCH_SUSPEITOS 32
+
+// ns por pista no placar: ajuste do suspeito e leitura do mais provável
+double benchPlacar(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    PlacarSuspeitos p = { .total = 0 };
+    uintptr_t acc = 0;
+    double t0 = agoraNs();
+    for (int i = 0; i < BENCH_CONSULTAS; i++) {
+        uint64_t r = proximoAleatorio(semente);
+        int suspeito = (int)(r % BENCH_SUSPEITOS);
+        ajustarPlacar(&p, suspeito < p.total ? suspeito : p.total, 1);
+        acc += liderDoPlacar(&p);
+    }
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    liberarPlacar(&p);
+    return t / BENCH_CONSULTAS;
+}
+
+#define BENCH_RANKING_JOGADORES 1024
+#define BENCH_RANKING_THREADS 4
+#define BENCH_RANKING_ATUALIZACOES 50000   // por thread
+
+// Ranking com BENCH_RANKING_JOGADORES já pontuados
+static RankingGlobal *rankingBench(uint64_t *semente) {
+    RankingGlobal *r = criarRanking(BENCH_RANKING_JOGADORES);
+    char nome[32];
+    for (int j = 0; j < BENCH_RANKING_JOGADORES; j++) {
+        snprintf(nome, sizeof(nome), "jogador%d", j);
+        int id = jogadorDoRanking(r, nome);
+        uint64_t x = proximoAleatorio(semente);
+        atualizarRanking(r, id, (uint32_t)(x % 600000), (uint32_t)((x >> 32) % 3000));
+    }
+    return r;
+}
+
+typedef struct TarefaRanking {
+    RankingGlobal *r;
+    int primeiro;        // atualiza os jogadores primeiro, primeiro + THREADS, ...
+    uint64_t semente;
+} TarefaRanking;
+
+static void *atualizarRankingBench(void *arg) {
+    TarefaRanking *t = arg;
+    for (int i = 0; i < BENCH_RANKING_ATUALIZACOES; i++) {
+        uint64_t x = proximoAleatorio(&t->semente);
+        int jogador = t->primeiro + (int)(x % (BENCH_RANKING_JOGADORES / BENCH_RANKING_THREADS)) *
+                                    BENCH_RANKING_THREADS;
+        atualizarRanking(t->r, jogador, (uint32_t)((x >> 16) % 600000), (uint32_t)((x >> 40) % 3000));
+    }
+    return NULL;
+}
+
+// ns por atualização (tempo de parede) com BENCH_RANKING_THREADS threads simultâneas
+double benchRankingAtualizacao(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    RankingGlobal *r = rankingBench(semente);
+    pthread_t threads[BENCH_RANKING_THREADS];
+    TarefaRanking tarefas[BENCH_RANKING_THREADS];
+    int iniciada[BENCH_RANKING_THREADS];
+    double t0 = agoraNs();
+    for (int i = 0; i < BENCH_RANKING_THREADS; i++) {
+        tarefas[i] = (TarefaRanking){ r, i, proximoAleatorio(semente) };
+        iniciada[i] = pthread_create(&threads[i], NULL, atualizarRankingBench, &tarefas[i]) == 0;
+        if (!iniciada[i]) atualizarRankingBench(&tarefas[i]);
+    }
+    for (int i = 0; i < BENCH_RANKING_THREADS; i++)
+        if (iniciada[i]) pthread_join(threads[i], NULL);
+    double t = agoraNs() - t0;
+    liberarRanking(r);
+    return t / (BENCH_RANKING_THREADS * BENCH_RANKING_ATUALIZACOES);
+}
+
+// ns por consulta de posição de um jogador aleatório
+double benchRankingPosicao(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    RankingGlobal *r = rankingBench(semente);
+    const int consultas = 20000;
+    uintptr_t acc = 0;
+    double t0 = agoraNs();
+    for (int i = 0; i < consultas; i++)
+        acc += posicaoNoRanking(r, (int)(proximoAleatorio(semente) % BENCH_RANKING_JOGADORES));
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    liberarRanking(r);
+    return t / consultas;
+}
+
+#define BENCH_NOS 4096
+
+/**
+ * benchNos()
+ * Padrão de alocação das salas: cria BENCH_NOS nós do tamanho de Room, libera
+ * metade em ordem aleatória, cria outra metade e libera todos, num pool novo
+ * da classe de Room (lajes ou malloc, conforme o backend "nos").
+ * Retorna ns por operação.
+ */
+double benchNos(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    static void *nos[BENCH_NOS];
+    PoolNos p = { .tamNo = CLASSE_DE_TAMANHO(sizeof(Room)) };
+    double t0 = agoraNs();
+    for (int i = 0; i < BENCH_NOS; i++) {
+        nos[i] = alocarNo(&p);
+        memset(nos[i], 0, sizeof(Room));
+    }
+    for (int i = 0; i < BENCH_NOS / 2; i++) {
+        int k = (int)(proximoAleatorio(semente) % BENCH_NOS);
+        liberarNo(&p, nos[k]);
+        nos[k] = NULL;
+    }
+    for (int i = 0; i < BENCH_NOS; i++) {
+        if (nos[i]) continue;
+        nos[i] = alocarNo(&p);
+        memset(nos[i], 0, sizeof(Room));
+    }
+    for (int i = 0; i < BENCH_NOS; i++) liberarNo(&p, nos[i]);
+    double t = agoraNs() - t0;
+    return t / (3 * BENCH_NOS);   // aproximado: alocações + liberações
+}
+
+static int compararEnderecos(const void *a, const void *b) {
+    uintptr_t x = *(const uintptr_t*)a, y = *(const uintptr_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * medirEspalhamentoNos()
+ * Cria BENCH_NOS salas intercaladas com textos de tamanhos variados (como na
+ * montagem dos andares) e mede os bytes consumidos e quantas páginas de 4 KiB
+ * as salas ocupam, com cada opção do backend "nos".
+ */
+void medirEspalhamentoNos(uint64_t *semente) {
+    static void *nos[BENCH_NOS], *textos[BENCH_NOS];
+    static uintptr_t paginas[BENCH_NOS];
+    const FamiliaBackend *f = buscarFamiliaBackend("nos");
+    int anterior = *f->escolha;
+    for (int o = 0; o < f->nOpcoes; o++) {
+        *f->escolha = f->opcoes[o].valor;
+        PoolNos p = { .tamNo = CLASSE_DE_TAMANHO(sizeof(Room)) };
+        size_t bytes = 0;
+        for (int i = 0; i < BENCH_NOS; i++) {
+            textos[i] = malloc(8 + proximoAleatorio(semente) % 56);
+            nos[i] = alocarNo(&p);
+            if (!textos[i]) { perror("malloc"); exit(EXIT_FAILURE); }
+            paginas[i] = (uintptr_t)nos[i] / 4096;
+#ifdef __GLIBC__
+            if (p.direto) bytes += malloc_usable_size(nos[i]) + sizeof(size_t);
+#else
+            if (p.direto) bytes += (p.tamNo + sizeof(size_t) + 15) & ~(size_t)15;
+#endif
+        }
+        if (!p.direto) bytes = p.nLajes * TAM_LAJE;
+        qsort(paginas, BENCH_NOS, sizeof(uintptr_t), compararEnderecos);
+        int nPaginas = 0;
+        for (int i = 0; i < BENCH_NOS; i++) nPaginas += i == 0 || paginas[i] != paginas[i - 1];
+        char rotulo[32];
+        snprintf(rotulo, sizeof(rotulo), "%s:", f->opcoes[o].nome);
+        printf("Salas com %-7s %zu KiB para %d nós (%.1f bytes/nó) em %d páginas de 4 KiB\n",
+               rotulo, bytes / 1024, BENCH_NOS, (double)bytes / BENCH_NOS, nPaginas);
+        for (int i = 0; i < BENCH_NOS; i++) {
+            liberarNo(&p, nos[i]);
+            free(textos[i]);
+        }
+    }
+    *f->escolha = anterior;
+}
+
+// ns por passo de caminhadas aleatórias da entrada até uma folha
+double benchCaminhada(Caso *caso, uint64_t *semente) {
+    Room *entrada = entradaPropriedade(caso->propriedade);
+    const int caminhadas = 100000;
+    long passos = 0;
+    uintptr_t acc = 0;
+    double t0 = agoraNs();
+    for (int i = 0; i < caminhadas; i++) {
+        Room *r = entrada;
+        while (r->left || r->right) {
+            Room *prox = (proximoAleatorio(semente) & 1) ? r->left : r->right;
+            r = prox ? prox : (r->left ? r->left : r->right);
+            passos++;
+        }
+        acc += (uintptr_t)r->id;
+    }
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    return passos ? t / passos : 0;
+}
+
+/**
+ * simularPartida()
+ * Joga uma partida sem E/S: caminhada aleatória até uma folha coletando as
+ * pistas de cada sala e contagem das pistas do suspeito mais citado.
+ * Retorna a sessão ao final (liberar com liberarSessao).
+ */
+Sessao *simularPartida(Caso *caso, uint64_t *semente) {
+    Sessao *s = criarSessao(entradaPropriedade(caso->propriedade));
+    s->caso = caso;
+    for (;;) {
+        int nPistas;
+        const int *pistas = pistasDaSala(&caso->procedencia, s->atual->id, &nPistas);
+        for (int i = 0; i < nPistas; i++) {
+            const char *texto = caso->procedencia.pistas[pistas[i]];
+            registrarPista(s->caderno, pistas[i], texto, s->atual,
+                           encontrarSuspeito(&caso->tabela, texto), s->movimento);
+        }
+        Room *r = s->atual;
+        if (!r->left && !r->right) break;
+        Room *prox = (proximoAleatorio(semente) & 1) ? r->left : r->right;
+        s->atual = prox ? prox : (r->left ? r->left : r->right);
+        s->movimento++;
+    }
+    int melhor = 0;
+    for (int i = 0; i < s->caderno->nSuspeitos; i++) {
+        int n = count_clues_for_suspect(s->caderno, &caso->tabela, s->caderno->suspeitos[i]);
+        if (n > melhor) melhor = n;
+    }
+    benchSumidouro = (uintptr_t)melhor;
+    return s;
+}
+
+// ns por partida completa simulada
+double benchPartida(Caso *caso, uint64_t *semente) {
+    const int n = 20000;
+    double t0 = agoraNs();
+    for (int i = 0; i < n; i++) liberarSessao(simularPartida(caso, semente));
+    return (agoraNs() - t0) / n;
+}
+
+#define BENCH_LINHAS 500000
+
+// Arquivo temporário com comandos de um cliente roteirizado (criado uma vez)
+FILE *roteiroBench(uint64_t *semente) {
+    static FILE *roteiro = NULL;
+    static const char *comandos[] = { "e", "d", "c", "h", "Sra. Rosa", "", "g", "12" };
+    if (roteiro) return roteiro;
+    roteiro = tmpfile();
+    if (!roteiro) { perror("tmpfile"); exit(EXIT_FAILURE); }
+    for (int i = 0; i < BENCH_LINHAS; i++)
+        fprintf(roteiro, "%s\n", comandos[proximoAleatorio(semente) % N_ELEMENTOS(comandos)]);
+    fflush(roteiro);
+    return roteiro;
+}
+
+// ns por linha lida com fgets() (leitura anterior ao LeitorEntrada)
+double benchLeituraFgets(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    FILE *f = roteiroBench(semente);
+    char linha[MAX_INPUT];
+    uintptr_t acc = 0;
+    rewind(f);
+    double t0 = agoraNs();
+    while (fgets(linha, sizeof(linha), f)) acc += strlen(linha);
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    return t / BENCH_LINHAS;
+}
+
+// ns por linha lida com lerLinha() sobre o mesmo arquivo
+double benchLeituraBlocos(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    FILE *f = roteiroBench(semente);
+    LeitorEntrada l = { fileno(f), NULL, 0, 0, 0, 0 };
+    VisaoLinha v;
+    uintptr_t acc = 0;
+    lseek(l.fd, 0, SEEK_SET);
+    double t0 = agoraNs();
+    while (lerLinha(&l, &v)) acc += v.tamanho;
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    liberarLeitor(&l);
+    return t / BENCH_LINHAS;
+}
+
+#define BENCH_COMANDOS_DIARIO 200000
+
+/**
+ * escreverDiarioBench()
+ * Grava BENCH_COMANDOS_DIARIO comandos em um diário temporário pelo backend
+ * pedido. Retorna ns por comando e grava em *chamadas as chamadas de sistema
+ * por comando (incluindo a criação e o fechamento).
+ */
+double escreverDiarioBench(int uring, uint64_t *semente, double *chamadas) {
+    static const char *comandos[] = { "e", "d", "c", "h", "m", "v", "r", "Sra. Rosa" };
+    char caminho[] = "/tmp/dq-diario-XXXXXX";
+    int fd = mkstemp(caminho);
+    if (fd < 0) { perror("mkstemp"); exit(EXIT_FAILURE); }
+    close(fd);
+    int anterior = usarIoUring;
+    usarIoUring = uring;
+    double t0 = agoraNs();
+    Diario *d = abrirDiario(caminho);
+    for (int i = 0; i < BENCH_COMANDOS_DIARIO; i++)
+        registrarComando(d, comandos[proximoAleatorio(semente) % N_ELEMENTOS(comandos)]);
+    descarregarDiario(d);
+    long total = chamadasDoDiario(d) + 1;   // + fechamento
+    fecharDiario(d);
+    double t = agoraNs() - t0;
+    usarIoUring = anterior;
+    unlink(caminho);
+    if (chamadas) *chamadas = (double)total / BENCH_COMANDOS_DIARIO;
+    return t / BENCH_COMANDOS_DIARIO;
+}
+
+double benchDiarioWrite(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    return escreverDiarioBench(0, semente, NULL);
+}
+
+// Sem io_uring disponível, mede o mesmo caminho write(2)
+double benchDiarioUring(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    return escreverDiarioBench(1, semente, NULL);
+}
+
+#define BENCH_SALAS_DESCRICAO 20000
+
+// Caso sintético com BENCH_SALAS_DESCRICAO descrições de alguns parágrafos
+DescricoesCaso *descricoesBench(uint64_t *semente, size_t *bytesTexto) {
+    static DescricoesCaso d;
+    static size_t total = 0;
+    static const char *frases[] = {
+        "As paredes estão cobertas de retratos de antepassados de olhar severo. ",
+        "Um relógio de pêndulo marca as horas com um estalo seco. ",
+        "O assoalho range a cada passo, denunciando qualquer visitante. ",
+        "Há um cheiro persistente de cera de vela e papel velho. ",
+        "Uma janela estreita deixa entrar a luz cinzenta da tarde. ",
+        "Móveis cobertos por lençóis brancos lembram fantasmas imóveis. ",
+    };
+    if (bytesTexto) *bytesTexto = total;
+    if (d.posicoes) return &d;
+    inicializarDescricoes(&d, BENCH_SALAS_DESCRICAO);
+    char texto[1024];
+    for (int sala = 0; sala < BENCH_SALAS_DESCRICAO; sala++) {
+        size_t n = (size_t)snprintf(texto, sizeof(texto), "Sala %d.\n\n", sala);
+        for (int f = 0; f < 8; f++) {
+            const char *frase = frases[proximoAleatorio(semente) % N_ELEMENTOS(frases)];
+            size_t tam = strlen(frase);
+            if (n + tam + 3 >= sizeof(texto)) break;
+            memcpy(texto + n, frase, tam + 1);
+            n += tam;
+            if (f == 3) { memcpy(texto + n, "\n\n", 3); n += 2; }
+        }
+        adicionarDescricao(&d, sala, texto);
+        total += n;
+    }
+    finalizarDescricoes(&d);
+    if (bytesTexto) *bytesTexto = total;
+    return &d;
+}
+
+// ns por descricaoDaSala() em uma caminhada: 90% das consultas às últimas salas
+double benchDescricao(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    DescricoesCaso *d = descricoesBench(semente, NULL);
+    int recentes[8] = {0};
+    uintptr_t acc = 0;
+    double t0 = agoraNs();
+    for (int i = 0; i < BENCH_CONSULTAS; i++) {
+        uint64_t r = proximoAleatorio(semente);
+        int sala;
+        if (r % 10 == 0) {
+            sala = (int)((r >> 8) % BENCH_SALAS_DESCRICAO);
+            recentes[(r >> 40) % 8] = sala;
+        } else {
+            sala = recentes[(r >> 8) % 8];
+        }
+        acc += (uintptr_t)descricaoDaSala(d, sala);
+    }
+    double t = agoraNs() - t0;
+    benchSumidouro = acc;
+    return t / BENCH_CONSULTAS;
+}
+
+#define BENCH_PASSOS_VISITA 2000
+#define BENCH_PENSAR_NS 20000.0      // tempo do jogador no prompt (não medido)
+
+/**
+ * visitarDescricoesBench()
+ * Desce por uma árvore sintética sobre as salas de descricoesBench() (filhos
+ * 2i+1 e 2i+2), recomeçando da raiz nas folhas. A cada passo o "jogador"
+ * pensa por BENCH_PENSAR_NS e só a chegada à sala seguinte é medida. Com
+ * `pf`, os filhos são entregues ao pré-carregador antes do tempo de pensar.
+ * Retorna ns por chegada.
+ */
+static double visitarDescricoesBench(Prefetcher *pf, uint64_t *semente) {
+    DescricoesCaso *d = descricoesBench(semente, NULL);
+    int sala = 0;
+    uintptr_t acc = 0;
+    double medido = 0;
+    for (int passo = 0; passo < BENCH_PASSOS_VISITA; passo++) {
+        int filhos[2] = { 2 * sala + 1, 2 * sala + 2 };
+        if (filhos[0] >= BENCH_SALAS_DESCRICAO) { sala = 0; continue; }
+        anteciparSalas(pf, filhos, filhos[1] < BENCH_SALAS_DESCRICAO ? 2 : 1);
+        double fimPensar = agoraNs() + BENCH_PENSAR_NS;
+        while (agoraNs() < fimPensar) sched_yield();
+        int prox = filhos[proximoAleatorio(semente) & 1];
+        if (prox >= BENCH_SALAS_DESCRICAO) prox = filhos[0];
+        double t0 = agoraNs();
+        acc += (uintptr_t)descricaoDaSala(d, prox);
+        medido += agoraNs() - t0;
+        sala = prox;
+    }
+    benchSumidouro = acc;
+    return medido / BENCH_PASSOS_VISITA;
+}
+
+double benchVisitaSemPrefetch(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    return visitarDescricoesBench(NULL, semente);
+}
+
+double benchVisitaComPrefetch(Caso *caso, uint64_t *semente) {
+    (void)caso;
+    Prefetcher *pf = iniciarPrefetcher(descricoesBench(semente, NULL));
+    double ns = visitarDescricoesBench(pf, semente);
+    encerrarPrefetcher(pf);
+    return ns;
+}
+
+typedef double (*FuncaoBench)(Caso *caso, uint64_t *semente);
+
+// Com `familia`, o benchmark roda uma vez por backend registrado ("nome_opção")
+static const struct {
+    const char *nome;
+    FuncaoBench funcao;
+    const char *familia;
+} BENCHMARKS[] = {
+    { "consulta_hash",  benchConsultaHash, "tabela" },
+    { "insercao",       benchInsercaoCaderno, "caderno" },
+    { "busca",          benchBuscaCaderno, "caderno" },
+    { "placar_suspeitos", benchPlacar, NULL },
+    { "ranking_atualizacao", benchRankingAtualizacao, NULL },
+    { "ranking_posicao", benchRankingPosicao, NULL },
+    { "caminhada_salas", benchCaminhada, NULL },
+    { "nos",            benchNos, "nos" },
+    { "leitura_fgets",  benchLeituraFgets, NULL },
+    { "leitura_blocos", benchLeituraBlocos, NULL },
+    { "diario_write",   benchDiarioWrite, NULL },
+    { "diario_uring",   benchDiarioUring, NULL },
+    { "descricao_sala", benchDescricao, NULL },
+    { "visita_sem_prefetch", benchVisitaSemPrefetch, NULL },
+    { "visita_com_prefetch", benchVisitaComPrefetch, NULL },
+    { "partida_completa", benchPartida, NULL },
+};
+
+/**
+ * executarBenchmarks()
+ * Roda cada benchmark BENCH_AMOSTRAS vezes e grava uma linha por benchmark
+ * ("nome amostra1 amostra2 ...", em ns/op) em `caminho`, no formato lido por
+ * comparar_bench. Também exibe médias e o relatório de memória de uma partida.
+ * Retorna 0 em caso de sucesso.
+ */
+int executarBenchmarks(PacoteCasos *pc, const char *caminho) {
+    FILE *out = fopen(caminho, "w");
+    if (!out) { perror(caminho); return -1; }
+    Caso *caso = &pc->casos[0];
+    uint64_t semente = 0x9E3779B97F4A7C15ull;
+
+    // backends em uso: as variantes de uma família são medidas uma a uma, as
+    // demais famílias ficam como abaixo
+    fprintf(out, "# detective-quest bench v1 (ns/op)\n# backends: ");
+    escreverBackendsEmUso(out);
+    fprintf(out, "\n");
+    printf("Backends: ");
+    escreverBackendsEmUso(stdout);
+    printf("\n\n%-24s %12s\n", "benchmark", "ns/op");
+    for (int b = 0; b < N_ELEMENTOS(BENCHMARKS); b++) {
+        const FamiliaBackend *f = BENCHMARKS[b].familia ? buscarFamiliaBackend(BENCHMARKS[b].familia) : NULL;
+        int anterior = f ? *f->escolha : 0;
+        for (int o = 0; o < (f ? f->nOpcoes : 1); o++) {
+            char nome[64];
+            if (f) {
+                *f->escolha = f->opcoes[o].valor;
+                snprintf(nome, sizeof(nome), "%s_%s", BENCHMARKS[b].nome, f->opcoes[o].nome);
+            } else {
+                snprintf(nome, sizeof(nome), "%s", BENCHMARKS[b].nome);
+            }
+            double soma = 0;
+            fprintf(out, "%s", nome);
+            BENCHMARKS[b].funcao(caso, &semente);   // aquecimento
+            for (int a = 0; a < BENCH_AMOSTRAS; a++) {
+                double ns = BENCHMARKS[b].funcao(caso, &semente);
+                fprintf(out, " %.3f", ns);
+                soma += ns;
+            }
+            fprintf(out, "\n");
+            printf("%-24s %12.2f\n", nome, soma / BENCH_AMOSTRAS);
+        }
+        if (f) *f->escolha = anterior;
+    }
+    fclose(out);
+
+    double chamadasWrite, chamadasUring;
+    escreverDiarioBench(0, &semente, &chamadasWrite);
+    escreverDiarioBench(1, &semente, &chamadasUring);
+    printf("\nChamadas de sistema por comando do diário: write(2) %.5f, io_uring %.5f\n",
+           chamadasWrite, chamadasUring);
+    size_t bytesTexto;
+    DescricoesCaso *d = descricoesBench(&semente, &bytesTexto);
+    printf("Descrições de %d salas: %zu KiB de texto, %zu KiB residentes (blob + índice + cache)\n",
+           BENCH_SALAS_DESCRICAO, bytesTexto / 1024,
+           (d->tamBlob + d->nBlocos * sizeof(uint32_t) + d->nSalas * sizeof(PosicaoDescricao) +
+            d->bytesCache) / 1024);
+    liberarDescricoes(d);
+    medirEspalhamentoNos(&semente);
+
+    Sessao *s = simularPartida(caso, &semente);
+    printf("\nMemória após uma partida simulada:");
+    mostrarMemoria(s, &caso->tabela, &caso->procedencia);
+    liberarSessao(s);
+    return 0;
+}
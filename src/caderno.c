@@ -0,0 +1,85 @@
+#include "detective.h"
+
+/* ----------------------------- Caderno e consultas ----------------------------- */
+
+void anexarIndice(ListaIndices *l, int pos) {
+    if (l->total == l->capacidade) {
+        int cap = l->capacidade ? l->capacidade * 2 : 4;
+        int *novo = realloc(l->itens, cap * sizeof(int));
+        if (!novo) { perror("realloc"); exit(EXIT_FAILURE); }
+        l->itens = novo;
+        l->capacidade = cap;
+    }
+    l->itens[l->total++] = pos;
+}
+
+// Estrutura de pistas dos novos cadernos (--backend caderno=bst|art|saltos)
+int indicePistasPadrao = INDICE_BST;
+
+void inicializarCaderno(Caderno *c) {
+    memset(c, 0, sizeof(*c));
+    c->indice = indicePistasPadrao;
+    inicializarListaSaltos(&c->saltos);
+}
+
+int cadernoContemPista(const Caderno *c, const char *clue) {
+    if (c->indice == INDICE_ART) return buscarNaRadix(&c->radix, clue);
+    if (c->indice == INDICE_SALTOS) return buscarNaListaSaltos((ListaSaltos*)&c->saltos, clue);
+    return buscarPista(c->arvore, clue);
+}
+
+void percorrerBst(const ClueNode *n, void (*visitar)(const char *pista, void *ctx), void *ctx) {
+    if (!n) return;
+    percorrerBst(n->left, visitar, ctx);
+    visitar(n->clue, ctx);
+    percorrerBst(n->right, visitar, ctx);
+}
+
+/**
+ * percorrerPistas()
+ * Visita as pistas do caderno em ordem alfabética, qualquer que seja a
+ * estrutura usada pelo caderno.
+ */
+void percorrerPistas(const Caderno *c, void (*visitar)(const char *pista, void *ctx), void *ctx) {
+    if (c->indice == INDICE_ART) percorrerRadix(c->radix.raiz, visitar, ctx);
+    else if (c->indice == INDICE_SALTOS) percorrerListaSaltos((ListaSaltos*)&c->saltos, visitar, ctx);
+    else percorrerBst(c->arvore, visitar, ctx);
+}
+
+// Retorna o id do suspeito ou -1 se o nome ainda não apareceu no caderno
+int procurarSuspeito(const Caderno *c, const char *nome) {
+    if (!nome) return -1;
+    for (int i = 0; i < c->nSuspeitos; i++)
+        if (strcmp(c->suspeitos[i], nome) == 0) return i;
+    return -1;
+}
+
+// Retorna o id do suspeito, registrando o nome se ainda não existir
+int idSuspeito(Caderno *c, const char *nome) {
+    int id = procurarSuspeito(c, nome);
+    if (id >= 0 || !nome) return id;
+    if (c->nSuspeitos == c->capSuspeitos) {
+        int cap = c->capSuspeitos ? c->capSuspeitos * 2 : 8;
+        char **nomes = realloc(c->suspeitos, cap * sizeof(char*));
+        if (nomes) c->suspeitos = nomes;
+        ListaIndices *listas = realloc(c->porSuspeito, cap * sizeof(ListaIndices));
+        if (listas) c->porSuspeito = listas;
+        if (!nomes || !listas) { perror("realloc"); exit(EXIT_FAILURE); }
+        memset(c->porSuspeito + c->capSuspeitos, 0, (cap - c->capSuspeitos) * sizeof(ListaIndices));
+        c->capSuspeitos = cap;
+    }
+    c->suspeitos[c->nSuspeitos] = strdup_safe(nome);
+    return c->nSuspeitos++;
+}
+
+ListaIndices *indiceDaSala(Caderno *c, int sala) {
+    if (sala >= c->nSalas) {
+        int n = sala + 1;
+        ListaIndices *novo = realloc(c->porSala, n * sizeof(ListaIndices));
+        if (!novo) { perror("realloc"); exit(EXIT_FAILURE); }
+        memset(novo + c->nSalas, 0, (n - c->nSalas) * sizeof(ListaIndices));
+        c->porSala = novo;
+        c->nSalas = n;
+    }
+    return &c->porSala[sala];
+}
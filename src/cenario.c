@@ -0,0 +1,317 @@
+#include "detective.h"
+
+/* ----------------------------- Construção do cenário ----------------------------- */
+
+// Planta da mansão: cada andar é uma subárvore; escadas ligam andares
+static const DefSala SALAS_TERREO[] = {
+    { "Entrada",    -1, 0 },
+    { "Salão",       0, 'e' },
+    { "Cozinha",     0, 'd' },
+    { "Biblioteca",  1, 'e' },
+    { "Escritório",  1, 'd' },
+    { "Varanda",     2, 'd' },
+};
+static const DefSala SALAS_SUPERIOR[] = { { "Quarto", -1, 0 } };
+static const DefSala SALAS_SOTAO[]    = { { "Sótão",  -1, 0 } };
+static const DefSala SALAS_SUBSOLO[]  = { { "Porão",  -1, 0 } };
+
+static const DefAndar ANDARES_CASA[] = {
+    { "Térreo",         SALAS_TERREO,   6, NULL,         0   },
+    { "Andar superior", SALAS_SUPERIOR, 1, "Cozinha",    'e' },
+    { "Sótão",          SALAS_SOTAO,    1, "Biblioteca", 'e' },
+    { "Subsolo",        SALAS_SUBSOLO,  1, "Escritório", 'd' },
+};
+static const DefPredio PREDIOS_MANSAO[] = {
+    { "Casa principal", ANDARES_CASA, 4 },
+};
+static const DefPropriedade PLANTA_MANSAO = { "Mansão", PREDIOS_MANSAO, 1 };
+
+// Planta do farol: outra disposição de andares (e outros ids de sala)
+static const DefSala SALAS_CAIS[] = {
+    { "Cais",              -1, 0 },
+    { "Casa do faroleiro",  0, 'e' },
+    { "Depósito",           0, 'd' },
+    { "Oficina",            1, 'd' },
+};
+static const DefSala SALAS_TORRE[]    = { { "Escadaria", -1, 0 }, { "Sala de rádio", 0, 'd' } };
+static const DefSala SALAS_LANTERNA[] = { { "Lanterna", -1, 0 } };
+
+static const DefAndar ANDARES_FAROL[] = {
+    { "Cais",     SALAS_CAIS,     4, NULL,        0   },
+    { "Torre",    SALAS_TORRE,    2, "Depósito",  'd' },
+    { "Lanterna", SALAS_LANTERNA, 1, "Escadaria", 'e' },
+};
+static const DefPredio PREDIOS_FAROL[] = {
+    { "Farol", ANDARES_FAROL, 3 },
+};
+static const DefPropriedade PLANTA_FAROL = { "Farol", PREDIOS_FAROL, 1 };
+
+// Sala pelo nome entre os andares carregados do prédio
+Room *buscarSalaNoPredio(Predio *p, const char *nome) {
+    for (int a = 0; a < p->def->nAndares; a++) {
+        Andar *andar = &p->andares[a];
+        if (!andar->carregado) continue;
+        for (int i = 0; i < andar->def->nSalas; i++)
+            if (strcmp(andar->salas[i]->name, nome) == 0) return andar->salas[i];
+    }
+    return NULL;
+}
+
+// Liga (ou desliga, com `entrada` NULL) a entrada do andar à sala de acesso
+void ligarAcesso(Andar *andar, Room *entrada) {
+    if (!andar->def->acesso) return;
+    Room *acesso = buscarSalaNoPredio(andar->predio, andar->def->acesso);
+    if (!acesso) return;
+    if (andar->def->ladoAcesso == 'e') acesso->left = entrada;
+    else acesso->right = entrada;
+}
+
+/**
+ * carregarAndar()
+ * Cria as salas de um andar a partir da definição, monta a subárvore interna
+ * e conecta a entrada à sala de acesso (se o andar dela já estiver carregado).
+ * Andares que dependem deste são conectados em seguida.
+ */
+void carregarAndar(Andar *andar) {
+    const DefAndar *def = andar->def;
+    if (andar->carregado) return;
+    andar->salas = malloc(def->nSalas * sizeof(Room*));
+    if (!andar->salas) { perror("malloc"); exit(EXIT_FAILURE); }
+    for (int i = 0; i < def->nSalas; i++) {
+        andar->salas[i] = criarSala(internar(andar->predio->propriedade->dic, def->salas[i].nome),
+                                    andar->primeiraSala + i);
+        andar->salas[i]->andar = andar;
+    }
+    for (int i = 0; i < def->nSalas; i++) {
+        const DefSala *ds = &def->salas[i];
+        if (ds->pai < 0) continue;
+        Room *pai = andar->salas[ds->pai];
+        if (ds->lado == 'e') pai->left = andar->salas[i];
+        else pai->right = andar->salas[i];
+    }
+    andar->carregado = 1;
+    ligarAcesso(andar, andar->salas[0]);
+
+    // andares acessados a partir deste
+    Predio *p = andar->predio;
+    for (int a = 0; a < p->def->nAndares; a++) {
+        Andar *outro = &p->andares[a];
+        if (outro != andar && outro->carregado) ligarAcesso(outro, outro->salas[0]);
+    }
+}
+
+/**
+ * descarregarAndar()
+ * Desconecta o andar da sala de acesso e libera suas salas. Andares acessados
+ * a partir dele ficam sem ligação até que ele seja carregado novamente.
+ */
+void descarregarAndar(Andar *andar) {
+    if (!andar->carregado) return;
+    ligarAcesso(andar, NULL);
+    for (int i = 0; i < andar->def->nSalas; i++) {
+        // ligações que saem do andar (escadas) não pertencem a ele;
+        // o nome pertence ao dicionário
+        liberarNo(&poolSalas, andar->salas[i]);
+    }
+    free(andar->salas);
+    andar->salas = NULL;
+    andar->carregado = 0;
+}
+
+/**
+ * construirPropriedade()
+ * Monta a hierarquia propriedade -> prédios -> andares e carrega todos os andares.
+ * Andares e salas são numerados na ordem da planta, a partir de 0 em cada
+ * propriedade. Os nomes das salas são internados em `dic`.
+ */
+Propriedade *construirPropriedade(const DefPropriedade *def, Dicionario *dic) {
+    int proximoIdAndar = 0;
+    Propriedade *prop = malloc(sizeof(Propriedade));
+    if (!prop) { perror("malloc"); exit(EXIT_FAILURE); }
+    prop->def = def;
+    prop->dic = dic;
+    prop->nSalas = 0;
+    prop->predios = calloc(def->nPredios, sizeof(Predio));
+    if (!prop->predios) { perror("calloc"); exit(EXIT_FAILURE); }
+    for (int p = 0; p < def->nPredios; p++) {
+        Predio *predio = &prop->predios[p];
+        predio->def = &def->predios[p];
+        predio->propriedade = prop;
+        predio->andares = calloc(predio->def->nAndares, sizeof(Andar));
+        if (!predio->andares) { perror("calloc"); exit(EXIT_FAILURE); }
+        for (int a = 0; a < predio->def->nAndares; a++) {
+            predio->andares[a].id = proximoIdAndar++;
+            predio->andares[a].primeiraSala = prop->nSalas;
+            prop->nSalas += predio->def->andares[a].nSalas;
+            predio->andares[a].def = &predio->def->andares[a];
+            predio->andares[a].predio = predio;
+        }
+        for (int a = 0; a < predio->def->nAndares; a++) carregarAndar(&predio->andares[a]);
+    }
+    return prop;
+}
+
+// Entrada da propriedade: primeira sala do primeiro andar do primeiro prédio
+Room *entradaPropriedade(const Propriedade *prop) {
+    const Andar *andar = &prop->predios[0].andares[0];
+    return andar->carregado ? andar->salas[0] : NULL;
+}
+
+// Pistas de cada sala da mansão
+static const PistaDeSala PISTAS_DO_CASO[] = {
+    { "Entrada",    "Pegadas lamacentas" },
+    { "Salão",      "Vidro quebrado" },
+    { "Cozinha",    "Faca com impressões" },
+    { "Biblioteca", "Livro deslocado" },
+    { "Escritório", "Carta rasgada" },
+    { "Quarto",     "Frascos vazios" },
+    { "Varanda",    "Fibra vermelha" },
+    { "Sótão",      "Marcas de arraste" },
+    { "Porão",      "Pegada pequena" },
+};
+
+// Associações pista -> suspeito do caso
+static const SuspeitoDePista SUSPEITOS_DO_CASO[] = {
+    { "Pegadas lamacentas",  "Sr. Verde" },
+    { "Vidro quebrado",      "Sra. Rosa" },
+    { "Faca com impressões", "Sr. Preto" },
+    { "Livro deslocado",     "Sra. Rosa" },
+    { "Carta rasgada",       "Sr. Preto" },
+    { "Frascos vazios",      "Dr. Azul" },
+    { "Fibra vermelha",      "Sra. Rosa" },
+    { "Marcas de arraste",   "Sr. Verde" },
+    { "Pegada pequena",      "Sra. Rosa" },
+};
+
+// Descrições longas das salas (guardadas comprimidas; ver construirDescricoes())
+static const DescricaoDeSala DESCRICOES_DO_CASO[] = {
+    { "Entrada",
+      "O hall de entrada é amplo e mal iluminado. Um lustre de cristal, coberto de poeira,\n"
+      "balança levemente com a corrente de ar que entra pela porta entreaberta.\n\n"
+      "O piso de mármore xadrez guarda marcas recentes de sapatos molhados, que seguem\n"
+      "em direção ao salão e à cozinha. Um guarda-chuva ainda pinga no suporte de latão." },
+    { "Salão",
+      "O salão de festas parece ter sido abandonado às pressas. Taças pela metade repousam\n"
+      "sobre o piano de cauda, e uma das janelas altas tem o vidro estilhaçado.\n\n"
+      "As cortinas de veludo vermelho estão rasgadas na barra, como se alguém tivesse\n"
+      "tropeçado nelas. No tapete persa, cacos de vidro formam um rastro até a biblioteca." },
+    { "Cozinha",
+      "A cozinha cheira a alho e a fumaça fria. Panelas de cobre pendem de ganchos sobre a\n"
+      "bancada central, e o fogão a lenha ainda guarda brasas quase apagadas.\n\n"
+      "O faqueiro está desfalcado: uma das facas de trinchar não está em seu lugar.\n"
+      "Uma escada estreita de serviço sobe em direção ao andar superior." },
+    { "Biblioteca",
+      "Estantes de mogno vão do chão ao teto, repletas de volumes encadernados em couro.\n"
+      "Uma poltrona de leitura está virada para a lareira, e o fogo já se apagou.\n\n"
+      "Na terceira prateleira, um livro está fora de ordem, com a lombada saliente, como se\n"
+      "tivesse sido puxado e devolvido com pressa. Um alçapão no teto leva ao sótão." },
+    { "Escritório",
+      "O escritório do dono da casa é sóbrio: uma escrivaninha de carvalho, um cofre de\n"
+      "parede e um mapa antigo da propriedade emoldurado acima da lareira.\n\n"
+      "Papéis estão espalhados pelo chão, e a gaveta de cima foi forçada. Pela porta dos\n"
+      "fundos, uma escada de pedra desce em direção ao porão." },
+    { "Varanda",
+      "A varanda dá para o jardim dos fundos, agora encharcado pela chuva. As cadeiras de\n"
+      "vime foram arrastadas para junto da balaustrada.\n\n"
+      "Presa em uma farpa do corrimão, uma fibra de tecido vermelho tremula ao vento." },
+    { "Quarto",
+      "O quarto principal tem uma cama de dossel desarrumada e um penteador coberto de\n"
+      "frascos de perfume e remédios.\n\n"
+      "Alguns frascos estão vazios e destampados, alinhados com um cuidado estranho, como\n"
+      "se alguém quisesse que fossem encontrados." },
+    { "Sótão",
+      "O sótão é baixo e abafado, atravancado de baús, molduras e móveis cobertos por\n"
+      "lençóis. A única luz vem de uma claraboia embaçada.\n\n"
+      "Na poeira do assoalho, dois sulcos paralelos indicam que algo pesado foi arrastado\n"
+      "até o canto mais escuro." },
+    { "Porão",
+      "O porão é úmido e frio. Garrafas de vinho ocupam prateleiras de madeira ao longo\n"
+      "das paredes de pedra, e uma lâmpada solitária pende do teto.\n\n"
+      "No chão de terra batida, uma pegada pequena e nítida destoa das demais." },
+};
+
+static const DescricaoDeSala DESCRICOES_DA_HERANCA[] = {
+    { "Entrada",
+      "O hall de entrada está decorado para a leitura do testamento: coroas de flores,\n"
+      "um livro de condolências e retratos da família enfileirados na parede.\n\n"
+      "Ao pé da escada, marcas de sapatos molhados cruzam o mármore." },
+    { "Escritório",
+      "O escritório foi revirado. O cofre de parede está aberto e vazio, e a escrivaninha\n"
+      "está coberta de pastas do cartório.\n\n"
+      "Sobre o mata-borrão, uma caneta-tinteiro sem tampa ainda está úmida." },
+};
+
+// Segundo caso na mesma planta (compartilha salas e parte dos textos)
+static const PistaDeSala PISTAS_DA_HERANCA[] = {
+    { "Entrada",    "Pegadas lamacentas" },
+    { "Salão",      "Taça com batom" },
+    { "Biblioteca", "Testamento rasurado" },
+    { "Escritório", "Cofre aberto" },
+    { "Quarto",     "Frascos vazios" },
+    { "Sótão",      "Baú arrombado" },
+    { "Porão",      "Pá suja de terra" },
+};
+
+static const SuspeitoDePista SUSPEITOS_DA_HERANCA[] = {
+    { "Pegadas lamacentas",  "Sr. Verde" },
+    { "Taça com batom",      "Sra. Rosa" },
+    { "Testamento rasurado", "Dr. Azul" },
+    { "Cofre aberto",        "Dr. Azul" },
+    { "Frascos vazios",      "Sra. Rosa" },
+    { "Baú arrombado",       "Sr. Verde" },
+    { "Pá suja de terra",    "Dr. Azul" },
+};
+
+
+// Terceiro caso, em outra planta
+static const PistaDeSala PISTAS_DO_FAROL[] = {
+    { "Cais",              "Corda cortada" },
+    { "Casa do faroleiro", "Diário arrancado" },
+    { "Depósito",          "Lata de querosene" },
+    { "Oficina",           "Pegadas lamacentas" },
+    { "Sala de rádio",     "Rádio sabotado" },
+    { "Lanterna",          "Lente trincada" },
+};
+
+static const SuspeitoDePista SUSPEITOS_DO_FAROL[] = {
+    { "Corda cortada",      "Capitão Neves" },
+    { "Diário arrancado",   "Sra. Rosa" },
+    { "Lata de querosene",  "Capitão Neves" },
+    { "Pegadas lamacentas", "Sr. Verde" },
+    { "Rádio sabotado",     "Capitão Neves" },
+    { "Lente trincada",     "Sr. Verde" },
+};
+
+static const DescricaoDeSala DESCRICOES_DO_FAROL[] = {
+    { "Cais",
+      "O cais de madeira range a cada onda. Um barco a remo está amarrado pela metade,\n"
+      "e a outra amarra pende solta na água escura.\n\n"
+      "As tábuas estão escorregadias de sal e algas, e uma lanterna de mão foi esquecida\n"
+      "sobre um caixote." },
+    { "Lanterna",
+      "No alto da torre, a grande lente do farol ocupa quase todo o espaço. O mecanismo de\n"
+      "rotação está parado e o vidro da cúpula está embaçado pela maresia.\n\n"
+      "Uma das faces da lente tem uma trinca recente, em forma de estrela." },
+};
+
+const DefCaso CASOS[] = {
+    { "mansao",  "O crime na mansão", &PLANTA_MANSAO,
+      PISTAS_DO_CASO, N_ELEMENTOS(PISTAS_DO_CASO), SUSPEITOS_DO_CASO, N_ELEMENTOS(SUSPEITOS_DO_CASO),
+      DESCRICOES_DO_CASO, N_ELEMENTOS(DESCRICOES_DO_CASO) },
+    { "heranca", "A herança perdida", &PLANTA_MANSAO,
+      PISTAS_DA_HERANCA, N_ELEMENTOS(PISTAS_DA_HERANCA), SUSPEITOS_DA_HERANCA, N_ELEMENTOS(SUSPEITOS_DA_HERANCA),
+      DESCRICOES_DA_HERANCA, N_ELEMENTOS(DESCRICOES_DA_HERANCA) },
+    { "farol",   "A luz apagada do farol", &PLANTA_FAROL,
+      PISTAS_DO_FAROL, N_ELEMENTOS(PISTAS_DO_FAROL), SUSPEITOS_DO_FAROL, N_ELEMENTOS(SUSPEITOS_DO_FAROL),
+      DESCRICOES_DO_FAROL, N_ELEMENTOS(DESCRICOES_DO_FAROL) },
+};
+const int N_CASOS = N_ELEMENTOS(CASOS);
+
+// Inicializa a tabela hash com associações pista -> suspeito
+void popularTabelaHash(TabelaPistas *table, const SuspeitoDePista *defs, int n, Dicionario *dic) {
+    // limpar
+    inicializarTabelaPistas(table, tabelaPistasPadrao);
+
+    for (int i = 0; i < n; i++)
+        inserirNaHash(table, internar(dic, defs[i].pista), internar(dic, defs[i].suspeito));
+}
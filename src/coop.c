@@ -0,0 +1,245 @@
+#include "detective.h"
+
+/* ----------------------------- Modo cooperativo (lockstep) ----------------------------- */
+
+// Coleta as pistas da sala em que o jogador está, creditando-as a ele
+void coletarPistasCoop(EstadoCoop *e, int jogador, TabelaPistas *table,
+                       const IndiceProcedencia *proc) {
+    Room *sala = e->posicao[jogador];
+    int nPistas;
+    const int *pistas = pistasDaSala(proc, sala->id, &nPistas);
+    for (int i = 0; i < nPistas; i++) {
+        const char *clue = proc->pistas[pistas[i]];
+        if (registrarPista(e->caderno, pistas[i], clue, sala,
+                           encontrarSuspeito(table, clue), e->tick)) {
+            e->pistasEncontradas[jogador]++;
+            printf("Detetive %d encontrou a pista \"%s\" em %s.\n", jogador + 1, clue, sala->name);
+        }
+    }
+}
+
+// Coleta feita pela thread de um detetive durante o tick
+typedef struct TarefaColeta {
+    EstadoCoop *e;
+    int jogador;
+    const IndiceProcedencia *proc;
+    const int *pistas;         // ids das pistas da sala
+    NoSaltos **nos;            // nó de cada pista no caderno da equipe
+    int nPistas;
+    int capacidade;            // entradas alocadas em `nos`, reaproveitadas entre ticks
+} TarefaColeta;
+
+// Uma thread por detetive, criada em iniciarCoop() e sincronizada com a
+// thread principal por duas barreiras a cada tick
+typedef struct PoolColeta {
+    TarefaColeta tarefas[MAX_JOGADORES];
+    pthread_t threads[MAX_JOGADORES];
+    int nThreads;              // threads criadas; as demais tarefas rodam na principal
+    int encerrar;
+    pthread_mutex_t preparo;   // segura as threads até as barreiras existirem
+    pthread_barrier_t inicio, fim;
+} PoolColeta;
+
+static void coletarEmParalelo(TarefaColeta *t) {
+    int nova;
+    for (int i = 0; i < t->nPistas; i++)
+        t->nos[i] = inserirNaListaSaltos(&t->e->caderno->saltos,
+                                         t->proc->pistas[t->pistas[i]], &nova);
+}
+
+// Laço de uma thread da coleta: espera o início do tick, coleta e espera o fim
+static void *trabalhadorColeta(void *arg) {
+    TarefaColeta *t = arg;
+    PoolColeta *p = t->e->coleta;
+    pthread_mutex_lock(&p->preparo);
+    pthread_mutex_unlock(&p->preparo);
+    for (;;) {
+        pthread_barrier_wait(&p->inicio);
+        if (p->encerrar) break;
+        coletarEmParalelo(t);
+        pthread_barrier_wait(&p->fim);
+    }
+    return NULL;
+}
+
+/**
+ * coletarTick()
+ * Cada detetive que se moveu insere as pistas da sua sala no caderno da equipe
+ * pela sua thread do pool. Depois das coletas, a thread principal credita cada
+ * pista nova ao detetive de menor número que a encontrou e acrescenta os
+ * registros, preservando a saída determinística do lockstep.
+ */
+void coletarTick(EstadoCoop *e, const int moveu[], TabelaPistas *table,
+                 const IndiceProcedencia *proc) {
+    PoolColeta *p = e->coleta;
+    TarefaColeta *tarefas = p->tarefas;
+    unsigned antes = atomic_load(&e->caderno->saltos.publicadas);
+
+    for (int j = 0; j < e->nJogadores; j++) {
+        TarefaColeta *t = &tarefas[j];
+        t->proc = proc;
+        t->nPistas = 0;
+        if (!moveu[j]) continue;
+        t->pistas = pistasDaSala(proc, e->posicao[j]->id, &t->nPistas);
+        if (t->nPistas > t->capacidade) {
+            t->capacidade = t->nPistas;
+            t->nos = realloc(t->nos, t->capacidade * sizeof(NoSaltos*));
+            if (!t->nos) { perror("realloc"); exit(EXIT_FAILURE); }
+        }
+    }
+    if (p->nThreads > 0) pthread_barrier_wait(&p->inicio);
+    for (int j = p->nThreads; j < e->nJogadores; j++) coletarEmParalelo(&tarefas[j]);
+    if (p->nThreads > 0) pthread_barrier_wait(&p->fim);
+
+    for (int j = 0; j < e->nJogadores; j++) {
+        TarefaColeta *t = &tarefas[j];
+        Room *sala = e->posicao[j];
+        for (int i = 0; i < t->nPistas; i++) {
+            NoSaltos *no = t->nos[i];
+            if (atomic_load(&no->seq) < antes) continue;   // já estava no caderno
+            int creditada = 0;
+            for (int k = 0; k < j && !creditada; k++)
+                for (int m = 0; m < tarefas[k].nPistas; m++)
+                    if (tarefas[k].nos[m] == no) { creditada = 1; break; }
+            for (int m = 0; m < i && !creditada; m++)
+                if (t->nos[m] == no) creditada = 1;
+            if (creditada) continue;
+            const char *clue = no->pista;
+            anexarRegistro(e->caderno, t->pistas[i], proc->pistas[t->pistas[i]], sala,
+                           encontrarSuspeito(table, clue), e->tick);
+            e->pistasEncontradas[j]++;
+            printf("Detetive %d encontrou a pista \"%s\" em %s.\n", j + 1, clue, sala->name);
+        }
+    }
+}
+
+/**
+ * iniciarCoop()
+ * Prepara o estado da equipe e cria as threads da coleta, que ficam paradas
+ * na barreira entre os ticks. Se alguma thread não puder ser criada, as
+ * tarefas dos detetives restantes rodam na thread principal.
+ */
+void iniciarCoop(EstadoCoop *e, Room *mansao, int nJogadores) {
+    memset(e, 0, sizeof(*e));
+    e->mansao = mansao;
+    e->nJogadores = nJogadores;
+    e->caderno = criarCaderno();
+    e->caderno->indice = INDICE_SALTOS;   // recebe inserções de várias threads
+    for (int j = 0; j < nJogadores; j++) {
+        e->posicao[j] = mansao;
+        e->ativo[j] = 1;
+    }
+
+    PoolColeta *p = calloc(1, sizeof(PoolColeta));
+    if (!p) { perror("calloc"); exit(EXIT_FAILURE); }
+    e->coleta = p;
+    pthread_mutex_init(&p->preparo, NULL);
+    pthread_mutex_lock(&p->preparo);
+    for (int j = 0; j < nJogadores; j++) {
+        p->tarefas[j].e = e;
+        p->tarefas[j].jogador = j;
+    }
+    while (p->nThreads < nJogadores &&
+           pthread_create(&p->threads[p->nThreads], NULL, trabalhadorColeta,
+                          &p->tarefas[p->nThreads]) == 0)
+        p->nThreads++;
+    if (p->nThreads > 0) {
+        pthread_barrier_init(&p->inicio, NULL, (unsigned)p->nThreads + 1);
+        pthread_barrier_init(&p->fim, NULL, (unsigned)p->nThreads + 1);
+    }
+    pthread_mutex_unlock(&p->preparo);
+}
+
+// Encerra as threads da coleta; o caderno da equipe continua com o chamador
+void encerrarCoop(EstadoCoop *e) {
+    PoolColeta *p = e->coleta;
+    if (!p) return;
+    if (p->nThreads > 0) {
+        p->encerrar = 1;
+        pthread_barrier_wait(&p->inicio);
+        for (int j = 0; j < p->nThreads; j++) pthread_join(p->threads[j], NULL);
+        pthread_barrier_destroy(&p->inicio);
+        pthread_barrier_destroy(&p->fim);
+    }
+    pthread_mutex_destroy(&p->preparo);
+    for (int j = 0; j < e->nJogadores; j++) free(p->tarefas[j].nos);
+    free(p);
+    e->coleta = NULL;
+}
+
+/**
+ * aplicarTick()
+ * Aplica um lote de comandos ao estado compartilhado. A ordem é fixa (jogador
+ * 0, 1, ...): primeiro todos os deslocamentos, depois as coletas, de modo que o
+ * mesmo lote produz sempre o mesmo estado. As coletas rodam em paralelo (ver
+ * coletarTick()), mas o crédito das pistas segue a mesma ordem fixa.
+ */
+void aplicarTick(EstadoCoop *e, const LoteTick *lote, TabelaPistas *table,
+                 const IndiceProcedencia *proc) {
+    int moveu[MAX_JOGADORES] = {0};
+    e->tick = lote->tick;
+    for (int j = 0; j < lote->nJogadores; j++) {
+        if (!e->ativo[j]) continue;
+        Room *r = e->posicao[j];
+        switch (lote->comandos[j]) {
+            case CMD_ESQUERDA: if (r->left)  { e->posicao[j] = r->left;  moveu[j] = 1; } break;
+            case CMD_DIREITA:  if (r->right) { e->posicao[j] = r->right; moveu[j] = 1; } break;
+            case CMD_SAIR:     e->ativo[j] = 0; break;
+            default: break;
+        }
+        e->movimentos[j] += moveu[j];
+        if (moveu[j]) contarMetrica(MET_MOVIMENTOS);
+    }
+    coletarTick(e, moveu, table, proc);
+}
+
+// Codifica o lote como uma linha compacta: "T<tick> <comandos>\n"
+int codificarLote(const LoteTick *lote, char *buf, size_t tam) {
+    return snprintf(buf, tam, "T%d %.*s\n", lote->tick, lote->nJogadores, lote->comandos);
+}
+
+/**
+ * explorarCoop()
+ * Exploração cooperativa em lockstep: a cada tick coleta o comando de cada
+ * detetive ativo, aplica o lote com aplicarTick() e transmite aos espectadores
+ * somente o lote de entradas.
+ */
+void explorarCoop(EstadoCoop *e, TabelaPistas *table, const IndiceProcedencia *proc,
+                  Transmissao *tx) {
+    VisaoLinha linha;
+    int ativos = e->nJogadores;
+
+    printf("\n--- Início da exploração cooperativa (%d detetives) ---\n", e->nJogadores);
+    if (e->tick == 0) coletarPistasCoop(e, 0, table, proc);   // sala inicial
+    while (ativos > 0) {
+        LoteTick lote = { e->tick + 1, e->nJogadores, {0} };
+        for (int j = 0; j < e->nJogadores; j++) {
+            lote.comandos[j] = CMD_FICAR;
+            if (!e->ativo[j]) continue;
+            printf("Detetive %d em %s - (e) esquerdo, (d) direito, (.) ficar, (s) sair: ",
+                   j + 1, e->posicao[j]->name);
+            if (!lerLinha(&entrada, &linha)) { lote.comandos[j] = CMD_SAIR; continue; }
+            char c = (char)tolower((unsigned char)linha.texto[0]);
+            if (c == CMD_ESQUERDA || c == CMD_DIREITA || c == CMD_SAIR) lote.comandos[j] = c;
+        }
+        int pistasAntes = e->caderno->total;
+        aplicarTick(e, &lote, table, proc);
+        int lider = liderDoPlacar(&e->caderno->placar);
+        if (e->caderno->total > pistasAntes && lider >= 0)
+            printf("Suspeito mais provável: %s (%d pista(s)).\n", e->caderno->suspeitos[lider],
+                   e->caderno->placar.pontos[lider]);
+
+        char linha[32 + MAX_JOGADORES];
+        int n = codificarLote(&lote, linha, sizeof(linha));
+        transmitirEspectadores(tx, linha, (size_t)n);
+        enviarEspectadores(tx);
+
+        ativos = 0;
+        for (int j = 0; j < e->nJogadores; j++) ativos += e->ativo[j];
+    }
+    printf("--- Fim da exploração cooperativa ---\n");
+    for (int j = 0; j < e->nJogadores; j++)
+        printf("Detetive %d: %d movimento(s), %d pista(s) encontrada(s)\n",
+               j + 1, e->movimentos[j], e->pistasEncontradas[j]);
+    printf("\n");
+}
@@ -0,0 +1,283 @@
+#include "detective.h"
+
+/* ----------------------------- Descrições das salas ----------------------------- */
+
+#define SEM_DESCRICAO UINT32_MAX
+
+void inicializarDescricoes(DescricoesCaso *d, int nSalas) {
+    memset(d, 0, sizeof(*d));
+    pthread_mutex_init(&d->trava, NULL);
+    d->fixado = SEM_DESCRICAO;
+    d->nSalas = nSalas;
+    d->posicoes = malloc((nSalas > 0 ? nSalas : 1) * sizeof(PosicaoDescricao));
+    if (!d->posicoes) { perror("malloc"); exit(EXIT_FAILURE); }
+    for (int i = 0; i < nSalas; i++) d->posicoes[i].bloco = SEM_DESCRICAO;
+}
+
+// Comprime o bloco em montagem e o acrescenta ao blob
+void fecharBlocoDescricoes(DescricoesCaso *d) {
+    if (d->usadoPendente == 0) return;
+    size_t limite = limiteBloco((uint32_t)d->usadoPendente);
+    if (d->tamBlob + limite > d->capacidadeBlob) {
+        size_t cap = d->capacidadeBlob ? d->capacidadeBlob : 4096;
+        while (cap < d->tamBlob + limite) cap *= 2;
+        uint8_t *novo = realloc(d->blob, cap);
+        if (!novo) { perror("realloc"); exit(EXIT_FAILURE); }
+        d->blob = novo;
+        d->capacidadeBlob = cap;
+    }
+    uint32_t *inicios = realloc(d->inicioBloco, (d->nBlocos + 1) * sizeof(uint32_t));
+    if (!inicios) { perror("realloc"); exit(EXIT_FAILURE); }
+    d->inicioBloco = inicios;
+    d->inicioBloco[d->nBlocos++] = (uint32_t)d->tamBlob;
+    d->tamBlob += montarBloco(d->pendente, (uint32_t)d->usadoPendente, d->blob + d->tamBlob);
+    d->usadoPendente = 0;
+}
+
+/**
+ * adicionarDescricao()
+ * Acrescenta a descrição da sala ao bloco em montagem (terminada em '\0'),
+ * fechando-o quando passaria de TAM_BLOCO_DESCRICOES.
+ */
+void adicionarDescricao(DescricoesCaso *d, int sala, const char *texto) {
+    if (sala < 0 || sala >= d->nSalas) return;
+    size_t n = strlen(texto) + 1;
+    if (d->usadoPendente > 0 && d->usadoPendente + n > TAM_BLOCO_DESCRICOES) fecharBlocoDescricoes(d);
+    if (d->usadoPendente + n > d->capacidadePendente) {
+        size_t cap = n > TAM_BLOCO_DESCRICOES ? n : TAM_BLOCO_DESCRICOES;
+        char *novo = realloc(d->pendente, cap);
+        if (!novo) { perror("realloc"); exit(EXIT_FAILURE); }
+        d->pendente = novo;
+        d->capacidadePendente = cap;
+    }
+    d->posicoes[sala].bloco = d->nBlocos;
+    d->posicoes[sala].deslocamento = (uint32_t)d->usadoPendente;
+    memcpy(d->pendente + d->usadoPendente, texto, n);
+    d->usadoPendente += n;
+}
+
+// Fecha o último bloco e devolve as folgas: a partir daqui só há leituras
+void finalizarDescricoes(DescricoesCaso *d) {
+    fecharBlocoDescricoes(d);
+    free(d->pendente);
+    d->pendente = NULL;
+    d->capacidadePendente = 0;
+    if (d->tamBlob > 0 && d->tamBlob < d->capacidadeBlob) {
+        uint8_t *justo = realloc(d->blob, d->tamBlob);
+        if (justo) {
+            d->blob = justo;
+            d->capacidadeBlob = d->tamBlob;
+        }
+    }
+}
+
+/**
+ * construirDescricoes()
+ * Comprime, no carregamento do caso, as descrições associadas às salas da
+ * mansão. Só o blob comprimido e a posição de cada sala ficam residentes;
+ * descrições de salas inexistentes são ignoradas.
+ */
+void construirDescricoes(DescricoesCaso *d, Room *mansao, const DescricaoDeSala *defs, int n) {
+    inicializarDescricoes(d, contarIdsSalas(mansao));
+    for (int i = 0; i < n; i++) {
+        Room *r = buscarSala(mansao, defs[i].sala);
+        if (r) adicionarDescricao(d, r->id, defs[i].texto);
+    }
+    finalizarDescricoes(d);
+}
+
+static void descartarDaCache(DescricoesCaso *d, int i) {
+    d->bytesCache -= d->cache[i].tamanho;
+    free(d->cache[i].texto);
+    d->cache[i] = d->cache[--d->nCache];
+}
+
+static int procurarNaCache(DescricoesCaso *d, uint32_t bloco) {
+    for (int i = 0; i < d->nCache; i++)
+        if (d->cache[i].bloco == bloco) return i;
+    return -1;
+}
+
+// Descomprime um bloco fora da trava; NULL se inválido
+static char *abrirBlocoDescricoes(const DescricoesCaso *d, uint32_t bloco, uint32_t *tam) {
+    if (bloco >= d->nBlocos) return NULL;   // ainda no bloco em montagem
+    uint32_t inicio = d->inicioBloco[bloco];
+    return abrirBlocoNaMemoria(d->blob + inicio, d->tamBlob - inicio, tam);
+}
+
+/**
+ * guardarNaCache()
+ * Insere um bloco descomprimido (chamar com a trava). Se outra thread já o
+ * inseriu, descarta `texto`. Abre espaço descartando o bloco menos usado,
+ * exceto o fixado. Retorna a posição do bloco no cache.
+ */
+static int guardarNaCache(DescricoesCaso *d, uint32_t bloco, char *texto, uint32_t tam) {
+    int i = procurarNaCache(d, bloco);
+    if (i >= 0) {
+        free(texto);
+        return i;
+    }
+    while (d->nCache > 0 &&
+           (d->nCache == CACHE_DESCRICOES || d->bytesCache + tam + 1 > CACHE_DESCRICOES_BYTES)) {
+        int lru = -1;
+        for (int k = 0; k < d->nCache; k++)
+            if (d->cache[k].bloco != d->fixado &&
+                (lru < 0 || d->cache[k].ultimoUso < d->cache[lru].ultimoUso)) lru = k;
+        if (lru < 0) break;
+        descartarDaCache(d, lru);
+    }
+    BlocoEmCache *e = &d->cache[d->nCache++];
+    e->bloco = bloco;
+    e->ultimoUso = ++d->relogio;
+    e->texto = texto;
+    e->tamanho = (size_t)tam + 1;
+    d->bytesCache += e->tamanho;
+    return d->nCache - 1;
+}
+
+/**
+ * descricaoDaSala()
+ * Retorna a descrição da sala, descomprimindo seu bloco na primeira consulta
+ * (ou depois de ele ter saído do cache), a menos que o pré-carregador já o
+ * tenha feito. O cache guarda no máximo CACHE_DESCRICOES blocos e
+ * CACHE_DESCRICOES_BYTES bytes, descartando o menos usado. O ponteiro vale até
+ * a próxima chamada. Retorna NULL se a sala não tem descrição.
+ */
+const char *descricaoDaSala(DescricoesCaso *d, int sala) {
+    if (sala < 0 || sala >= d->nSalas || d->posicoes[sala].bloco == SEM_DESCRICAO) return NULL;
+    PosicaoDescricao pos = d->posicoes[sala];
+    pthread_mutex_lock(&d->trava);
+    int i = procurarNaCache(d, pos.bloco);
+    if (i < 0) {
+        pthread_mutex_unlock(&d->trava);
+        uint32_t tam;
+        char *texto = abrirBlocoDescricoes(d, pos.bloco, &tam);
+        if (!texto || pos.deslocamento >= tam) { free(texto); return NULL; }
+        pthread_mutex_lock(&d->trava);
+        i = guardarNaCache(d, pos.bloco, texto, tam);
+    }
+    d->cache[i].ultimoUso = ++d->relogio;
+    d->fixado = pos.bloco;
+    const char *resultado = d->cache[i].texto + pos.deslocamento;
+    pthread_mutex_unlock(&d->trava);
+    return resultado;
+}
+
+void liberarDescricoes(DescricoesCaso *d) {
+    while (d->nCache > 0) descartarDaCache(d, 0);
+    free(d->blob);
+    free(d->inicioBloco);
+    free(d->posicoes);
+    free(d->pendente);
+    pthread_mutex_destroy(&d->trava);
+    memset(d, 0, sizeof(*d));
+}
+
+/* ----------------------------- Pré-carregamento de salas ----------------------------- */
+
+// Descomprime antecipadamente o bloco da sala, se ainda não estiver no cache
+static void preCarregarSala(Prefetcher *pf, int sala) {
+    DescricoesCaso *d = pf->descricoes;
+    if (sala < 0 || sala >= d->nSalas || d->posicoes[sala].bloco == SEM_DESCRICAO) return;
+    uint32_t bloco = d->posicoes[sala].bloco;
+    pthread_mutex_lock(&d->trava);
+    int presente = procurarNaCache(d, bloco) >= 0;
+    pthread_mutex_unlock(&d->trava);
+    if (presente) return;
+    uint32_t tam;
+    char *texto = abrirBlocoDescricoes(d, bloco, &tam);
+    if (!texto) return;
+    pthread_mutex_lock(&d->trava);
+    guardarNaCache(d, bloco, texto, tam);
+    pthread_mutex_unlock(&d->trava);
+    contarMetrica(MET_BLOCOS_ANTECIPADOS);
+}
+
+void *executarPrefetcher(void *arg) {
+    Prefetcher *pf = arg;
+    int salas[MAX_PREFETCH];
+    pthread_mutex_lock(&pf->trava);
+    for (;;) {
+        while (pf->nPedidos == 0 && !pf->encerrar) pthread_cond_wait(&pf->sinal, &pf->trava);
+        if (pf->encerrar) break;
+        int n = pf->nPedidos;
+        memcpy(salas, pf->pedidos, n * sizeof(int));
+        pf->nPedidos = 0;
+        pthread_mutex_unlock(&pf->trava);
+        for (int i = 0; i < n; i++) preCarregarSala(pf, salas[i]);
+        pthread_mutex_lock(&pf->trava);
+    }
+    pthread_mutex_unlock(&pf->trava);
+    return NULL;
+}
+
+// Cria o pré-carregador; retorna NULL se a thread não puder ser criada
+Prefetcher *iniciarPrefetcher(DescricoesCaso *d) {
+    Prefetcher *pf = calloc(1, sizeof(Prefetcher));
+    if (!pf) { perror("calloc"); exit(EXIT_FAILURE); }
+    pf->descricoes = d;
+    pthread_mutex_init(&pf->trava, NULL);
+    pthread_cond_init(&pf->sinal, NULL);
+    if (pthread_create(&pf->thread, NULL, executarPrefetcher, pf) != 0) {
+        pthread_mutex_destroy(&pf->trava);
+        pthread_cond_destroy(&pf->sinal);
+        free(pf);
+        return NULL;
+    }
+    return pf;
+}
+
+/**
+ * anteciparSalas()
+ * Entrega ao pré-carregador as salas que o jogador deve visitar em seguida,
+ * em ordem de prioridade. Substitui o pedido anterior, se ainda não atendido.
+ */
+void anteciparSalas(Prefetcher *pf, const int *salas, int n) {
+    if (!pf) return;
+    if (n > MAX_PREFETCH) n = MAX_PREFETCH;
+    pthread_mutex_lock(&pf->trava);
+    memcpy(pf->pedidos, salas, n * sizeof(int));
+    pf->nPedidos = n;
+    pthread_cond_signal(&pf->sinal);
+    pthread_mutex_unlock(&pf->trava);
+}
+
+void encerrarPrefetcher(Prefetcher *pf) {
+    if (!pf) return;
+    pthread_mutex_lock(&pf->trava);
+    pf->encerrar = 1;
+    pthread_cond_signal(&pf->sinal);
+    pthread_mutex_unlock(&pf->trava);
+    pthread_join(pf->thread, NULL);
+    pthread_mutex_destroy(&pf->trava);
+    pthread_cond_destroy(&pf->sinal);
+    free(pf);
+}
+
+// Contabiliza o movimento nas estatísticas agregadas do caso
+void registrarIda(Caso *caso, const Room *de, const Room *para) {
+    if (!caso || !caso->idas || de->id >= caso->procedencia.nSalas) return;
+    caso->idas[de->id][para == de->right]++;
+}
+
+/**
+ * preverSalas()
+ * Lista as salas prováveis a partir de `sala`: os dois filhos e, depois, o
+ * caminho seguido pela maioria dos movimentos já registrados no caso (até
+ * PREFETCH_PROFUNDIDADE passos). Retorna quantas salas gravou em `saida`.
+ */
+int preverSalas(const Caso *caso, const Room *sala, int *saida, int max) {
+    int n = 0;
+    if (sala->left && n < max) saida[n++] = sala->left->id;
+    if (sala->right && n < max) saida[n++] = sala->right->id;
+    const Room *r = sala;
+    for (int passo = 0; passo < PREFETCH_PROFUNDIDADE && caso && caso->idas; passo++) {
+        if (r->id >= caso->procedencia.nSalas) break;
+        unsigned esq = caso->idas[r->id][0], dir = caso->idas[r->id][1];
+        const Room *prox = esq == 0 && dir == 0 ? NULL : (esq >= dir ? r->left : r->right);
+        if (!prox) break;
+        if (passo > 0 && n < max) saida[n++] = prox->id;   // os filhos já entraram
+        r = prox;
+    }
+    return n;
+}
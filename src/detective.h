@@ -0,0 +1,1078 @@
+/*
+ Detective Quest - declarações compartilhadas
+
+ Estruturas, constantes e funções usadas entre as unidades de src/.
+ Cada bloco de protótipos corresponde a um arquivo .c.
+*/
+
+#ifndef DETECTIVE_H
+#define DETECTIVE_H
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#include <execinfo.h>
+#include <sys/time.h>
+#define TEM_PERFIL 1
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define TEM_IO_URING 1
+#endif
+#endif
+
+#define HASH_SIZE 101
+#undef MAX_INPUT   // linux/limits.h (incluído por linux/io_uring.h) também o define
+#define MAX_INPUT 256
+
+/* ----------------------------- Estruturas ----------------------------- */
+
+#define TAM_BLOCO_ENTRADA (1 << 16)
+
+// Leitor de entrada em blocos grandes. As linhas são entregues como visões
+// sobre o próprio buffer (o '\n' vira '\0'), válidas até a próxima leitura.
+typedef struct LeitorEntrada {
+    int fd;
+    char *buffer;
+    size_t capacidade;   // bytes alocados (um a mais é reservado para o '\0' final)
+    size_t inicio;       // primeiro byte ainda não entregue
+    size_t fim;          // bytes válidos no buffer
+    int eof;
+} LeitorEntrada;
+
+typedef struct VisaoLinha {
+    const char *texto;   // terminado em '\0', sem o '\n'
+    size_t tamanho;
+} VisaoLinha;
+
+// Nó da árvore de cômodos
+typedef struct Room {
+    int id;          // posição da sala na planta da propriedade (usado pelos índices)
+    const char *name;      // texto do dicionário compartilhado
+    struct Andar *andar;   // andar que contém a sala
+    struct Room *left;
+    struct Room *right;
+} Room;
+
+// Definições estáticas da planta: salas de um andar, andares de um prédio
+// e prédios da propriedade
+typedef struct DefSala {
+    const char *nome;
+    int pai;       // índice da sala-mãe no mesmo andar (-1 = entrada do andar)
+    char lado;     // 'e' ou 'd' em relação à sala-mãe
+} DefSala;
+
+typedef struct DefAndar {
+    const char *nome;
+    const DefSala *salas;
+    int nSalas;
+    const char *acesso;   // sala de outro andar que leva à entrada deste (NULL = nenhum)
+    char ladoAcesso;
+} DefAndar;
+
+typedef struct DefPredio {
+    const char *nome;
+    const DefAndar *andares;
+    int nAndares;
+} DefPredio;
+
+typedef struct DefPropriedade {
+    const char *nome;
+    const DefPredio *predios;
+    int nPredios;
+} DefPropriedade;
+
+// Andar: unidade compacta e carregável de forma independente, dona de suas salas.
+// Os ids vêm da planta, então recarregar um andar devolve às salas os mesmos ids.
+typedef struct Andar {
+    int id;                // posição do andar na propriedade
+    int primeiraSala;      // id de salas[0]; as demais seguem a ordem da definição
+    const DefAndar *def;
+    Room **salas;          // salas na ordem da definição; salas[0] é a entrada
+    int carregado;
+    struct Predio *predio;
+} Andar;
+
+typedef struct Predio {
+    const DefPredio *def;
+    Andar *andares;
+    struct Propriedade *propriedade;
+} Predio;
+
+// Dicionário de textos compartilhado: cada texto distinto (nome de sala, pista,
+// suspeito) é armazenado uma única vez e referenciado por ponteiro
+typedef struct Dicionario {
+    char **textos;        // tabela de endereçamento aberto
+    size_t capacidade;    // potência de 2
+    size_t total;
+} Dicionario;
+
+// Mapa texto internado -> inteiro, em endereçamento aberto; as chaves vêm do
+// dicionário, então a comparação é por ponteiro
+typedef struct MapaTextos {
+    const char **chaves;
+    int *valores;
+    size_t capacidade;    // potência de 2, ao menos o dobro das chaves
+} MapaTextos;
+
+// Propriedade -> prédios -> andares -> salas
+typedef struct Propriedade {
+    const DefPropriedade *def;
+    Predio *predios;
+    Dicionario *dic;
+    int nSalas;            // ids de sala vão de 0 a nSalas - 1
+} Propriedade;
+
+// Nó da BST de pistas
+typedef struct ClueNode {
+    char *clue;
+    struct ClueNode *left;
+    struct ClueNode *right;
+} ClueNode;
+
+// Árvore radix adaptativa (ART) de pistas: cada nível consome um byte da chave,
+// incluindo o '\0' final (assim nenhuma chave é prefixo de outra). Nós internos
+// crescem de 4 para 16, 48 e 256 filhos, e trechos sem ramificação ficam
+// comprimidos no prefixo do nó. Folhas são marcadas no bit baixo do ponteiro.
+#define ART_PREFIXO_MAX 8
+
+enum { ART_NO4, ART_NO16, ART_NO48, ART_NO256 };
+
+typedef struct NoArt {
+    uint8_t tipo;
+    uint16_t nFilhos;
+    uint32_t tamPrefixo;                // tamanho real do prefixo comprimido
+    uint8_t prefixo[ART_PREFIXO_MAX];   // primeiros bytes do prefixo
+} NoArt;
+
+// Nós de 4 e 16 filhos: chaves ordenadas e filhos na mesma posição
+typedef struct NoArt4 {
+    NoArt h;
+    uint8_t chaves[4];
+    NoArt *filhos[4];
+} NoArt4;
+
+typedef struct NoArt16 {
+    NoArt h;
+    uint8_t chaves[16];
+    NoArt *filhos[16];
+} NoArt16;
+
+// Nó de 48 filhos: indice[byte] = posição + 1 em filhos (0 = ausente)
+typedef struct NoArt48 {
+    NoArt h;
+    uint8_t indice[256];
+    NoArt *filhos[48];
+} NoArt48;
+
+typedef struct NoArt256 {
+    NoArt h;
+    NoArt *filhos[256];
+} NoArt256;
+
+typedef struct FolhaArt {
+    uint32_t tamanho;   // bytes da chave, incluindo o '\0'
+    char chave[];
+} FolhaArt;
+
+typedef struct ArvoreRadix {
+    NoArt *raiz;
+    int total;
+} ArvoreRadix;
+
+// Lista de saltos concorrente de pistas (somente inserção, sem travas): várias
+// threads inserem ao mesmo tempo com compare-and-swap. Cada pista recebe um
+// número de sequência após entrar no nível 0; as sequências são publicadas em
+// ordem, e um instantâneo com `publicadas = S` enxerga exatamente as S primeiras.
+#define SALTOS_NIVEIS 16
+#define SALTOS_SEM_SEQUENCIA UINT32_MAX
+
+typedef struct NoSaltos {
+    const char *pista;        // aponta para o fim do próprio nó
+    atomic_uint seq;          // ordem de inserção (SALTOS_SEM_SEQUENCIA até ser numerada)
+    int niveis;
+    _Atomic(struct NoSaltos*) prox[];
+} NoSaltos;
+
+typedef struct ListaSaltos {
+    _Atomic(NoSaltos*) cabeca[SALTOS_NIVEIS];
+    atomic_uint proximaSeq;
+    atomic_uint publicadas;
+} ListaSaltos;
+
+// Ranking global de jogadores: lista de saltos sem travas, com remoção, ordenada
+// por (chave, jogador). A chave junta o tempo de solução (32 bits altos) e a
+// eficiência invertida (baixos), de modo que menor = melhor. A remoção marca o
+// bit baixo dos elos do nó; buscas posteriores o desligam. Nós desligados vão
+// para a lista de aposentados e só são liberados em liberarRanking().
+#define RANKING_NIVEIS 20
+#define RANKING_MARCA ((uintptr_t)1)
+#define RANKING_AUSENTE UINT64_MAX      // jogador ainda sem pontuação
+#define RANKING_MAX_JOGADORES 4096
+
+typedef struct NoRanking {
+    uint64_t chave;
+    uint32_t jogador;
+    int niveis;
+    struct NoRanking *aposentado;       // próximo na lista de aposentados
+    _Atomic(uintptr_t) prox[];          // elos com o bit de remoção
+} NoRanking;
+
+typedef struct RankingGlobal {
+    NoRanking *cabeca;                  // sentinela com RANKING_NIVEIS níveis
+    _Atomic(uint64_t) *chaves;          // jogador -> chave atual
+    char **nomes;                       // jogador -> nome
+    int nJogadores;
+    int maxJogadores;
+    _Atomic(NoRanking*) aposentados;
+} RankingGlobal;
+
+// Linha do ranking devolvida pelas consultas
+typedef struct ItemRanking {
+    uint32_t jogador;
+    uint32_t tempoMs;
+    uint32_t eficiencia;                // pistas por movimento x 1000
+} ItemRanking;
+
+// Estrutura usada pelo caderno para guardar as pistas em ordem alfabética
+typedef enum { INDICE_BST, INDICE_ART, INDICE_SALTOS } IndicePistas;
+
+// Cadeias da tabela hash: inserção na cabeça, ou ordenadas pela pista para que
+// uma consulta sem resultado pare no meio da cadeia (--backend tabela=...)
+enum { TABELA_ENCADEADA, TABELA_ORDENADA };
+
+// Entrada da tabela hash (cadeia simples)
+typedef struct HashEntry {
+    const char *key;       // pista (texto do dicionário compartilhado)
+    const char *suspect;   // suspeito associado
+    struct HashEntry *next;
+} HashEntry;
+
+// Tabela pista -> suspeito; a organização das cadeias é fixada ao inicializar,
+// de modo que trocar o backend depois não afeta tabelas já montadas
+typedef struct TabelaPistas {
+    HashEntry *baldes[HASH_SIZE];
+    int organizacao;       // TABELA_ENCADEADA ou TABELA_ORDENADA
+} TabelaPistas;
+
+// Registro de uma pista coletada: procedência e momento da descoberta
+typedef struct RegistroPista {
+    const char *pista;  // texto da pista
+    int sala;           // id da sala onde foi encontrada
+    int andar;          // id do andar da sala (-1 se fora da planta)
+    int suspeito;       // id do suspeito associado (-1 se nenhum)
+    int movimento;      // número do movimento em que foi descoberta
+} RegistroPista;
+
+// Lista de posições em Caderno.registros (índice secundário)
+typedef struct ListaIndices {
+    int *itens;
+    int total;
+    int capacidade;
+} ListaIndices;
+
+// Evento da linha do tempo: pista descoberta e movimento da descoberta
+typedef struct EventoPista {
+    int pista;       // id da pista (IndiceProcedencia)
+    int movimento;
+} EventoPista;
+
+// Log contíguo, somente de acréscimo, em ordem de descoberta
+typedef struct LinhaDoTempo {
+    EventoPista *eventos;
+    int total;
+    int capacidade;
+} LinhaDoTempo;
+
+// Placar ao vivo: heap binário máximo indexado pelo id do suspeito, ordenado
+// pela quantidade de pistas contra cada um (empate: quem apareceu primeiro).
+// Os três vetores crescem juntos, conforme novos suspeitos aparecem.
+typedef struct PlacarSuspeitos {
+    int *heap;                    // ids de suspeitos; heap[0] é o mais provável
+    int *posicao;                 // id do suspeito -> posição em heap
+    int *pontos;                  // pistas contra o suspeito
+    int total;                    // suspeitos no heap (ids 0..total-1)
+    int capacidade;
+} PlacarSuspeitos;
+
+// Caderno do jogador: BST ou ART em ordem alfabética + registros em ordem de descoberta
+// com índices secundários por suspeito e por sala. A linha do tempo é paralela
+// aos registros (mesma posição) e serve de índice por tempo.
+typedef struct Caderno {
+    int refs;                         // sessões que compartilham este caderno
+    IndicePistas indice;              // qual das estruturas abaixo está em uso
+    ClueNode *arvore;
+    ArvoreRadix radix;
+    ListaSaltos saltos;               // única estrutura segura para inserções paralelas
+    LinhaDoTempo linha;
+    RegistroPista *registros;
+    int total;
+    int capacidade;
+    char **suspeitos;                 // id do suspeito -> nome
+    ListaIndices *porSuspeito;        // paralelo a suspeitos
+    int nSuspeitos;
+    int capSuspeitos;
+    PlacarSuspeitos placar;           // suspeitos por pistas, atualizado a cada registro
+    ListaIndices *porSala;            // indexado pelo id da sala
+    int nSalas;
+} Caderno;
+
+// Filtro de consulta; campos "vazios" (NULL / -1) não restringem o resultado
+typedef struct FiltroPistas {
+    const char *suspeito;
+    int sala;
+    int movimentoMin;
+    int movimentoMax;   // -1 = sem limite superior
+    int andar;
+} FiltroPistas;
+
+// Associação estática sala -> pista usada na montagem do caso
+typedef struct PistaDeSala {
+    const char *sala;
+    const char *pista;
+} PistaDeSala;
+
+// Descrição longa de uma sala, definida pelo caso
+typedef struct DescricaoDeSala {
+    const char *sala;
+    const char *texto;
+} DescricaoDeSala;
+
+#define TAM_BLOCO_DESCRICOES (8 * 1024)       // texto agrupado por bloco comprimido
+#define CACHE_DESCRICOES 8                    // blocos descomprimidos mantidos
+#define CACHE_DESCRICOES_BYTES (64 * 1024)    // limite de bytes do cache
+
+// Posição da descrição de uma sala: bloco do blob e deslocamento no texto dele
+typedef struct PosicaoDescricao {
+    uint32_t bloco;
+    uint32_t deslocamento;
+} PosicaoDescricao;
+
+typedef struct BlocoEmCache {
+    uint32_t bloco;
+    unsigned ultimoUso;
+    char *texto;
+    size_t tamanho;
+} BlocoEmCache;
+
+// Descrições do caso: textos agrupados em blocos LZ de ~8 KiB (o compressor
+// aproveita a repetição entre salas vizinhas) em um único blob, e um cache LRU
+// limitado com os blocos já descomprimidos
+typedef struct DescricoesCaso {
+    uint8_t *blob;
+    size_t tamBlob;
+    size_t capacidadeBlob;
+    uint32_t *inicioBloco;        // posição de cada bloco no blob
+    uint32_t nBlocos;
+    PosicaoDescricao *posicoes;   // indexado pelo id da sala
+    int nSalas;
+    char *pendente;               // texto do bloco em montagem (NULL depois de finalizar)
+    size_t usadoPendente, capacidadePendente;
+    pthread_mutex_t trava;        // protege o cache (o pré-carregador também escreve)
+    BlocoEmCache cache[CACHE_DESCRICOES];
+    int nCache;
+    size_t bytesCache;
+    unsigned relogio;
+    uint32_t fixado;              // bloco do último texto entregue: não é descartado
+} DescricoesCaso;
+
+#define MAX_PREFETCH 16           // salas por pedido de pré-carregamento
+#define PREFETCH_PROFUNDIDADE 4   // passos seguidos pelo caminho mais provável
+
+// Pré-carregador: uma thread que, enquanto o jogador está no prompt,
+// descomprime os blocos de descrição das salas para onde ele deve ir
+typedef struct Prefetcher {
+    pthread_t thread;
+    pthread_mutex_t trava;
+    pthread_cond_t sinal;
+    DescricoesCaso *descricoes;
+    int pedidos[MAX_PREFETCH];
+    int nPedidos;
+    int encerrar;
+} Prefetcher;
+
+// Índice de procedência bidirecional sala <-> pista em formato CSR:
+// as pistas da sala s ficam em pistasDaSala[inicioSala[s] .. inicioSala[s+1]),
+// e as salas da pista p em salasDaPista[inicioPista[p] .. inicioPista[p+1]).
+typedef struct IndiceProcedencia {
+    int nSalas;
+    int nPistas;
+    const char **pistas;   // id da pista -> texto
+    int *inicioSala;
+    int *pistasDaSala;
+    int *inicioPista;
+    int *salasDaPista;
+    MapaTextos idsPistas;          // texto internado -> id da pista
+    const Dicionario *dic;
+} IndiceProcedencia;
+
+// Bloco de saída renderizado uma única vez e compartilhado (por contagem de
+// referências) entre todos os espectadores que ainda não o enviaram
+typedef struct BlocoSaida {
+    int refs;
+    size_t tamanho;
+    char dados[];
+} BlocoSaida;
+
+#define MAX_ESPECTADORES 16
+#define MAX_PENDENTES 64
+
+typedef struct Espectador {
+    int fd;           // -1: FIFO ainda sem leitor (nova tentativa a cada envio)
+    const char *caminho;
+    BlocoSaida *pendentes[MAX_PENDENTES];
+    int nPendentes;
+    size_t enviado;   // bytes já enviados do primeiro bloco pendente
+} Espectador;
+
+// Transmissão da sessão: o jogador recebe a saída por stdout e cada espectador
+// recebe referências aos mesmos blocos, enviados em lote com writev() em
+// descritores não bloqueantes (um espectador lento nunca trava o jogo)
+typedef struct Transmissao {
+    Espectador espectadores[MAX_ESPECTADORES];
+    int nEspectadores;
+} Transmissao;
+
+// Estado de uma sessão de jogo. A mansão é imutável e compartilhada; o caderno
+// é compartilhado entre sessões bifurcadas até que uma delas o modifique.
+typedef struct Sessao {
+    struct Caso *caso;
+    Room *mansao;
+    Room *atual;
+    int movimento;
+    Caderno *caderno;
+    struct Diario *diario;   // diário de comandos (NULL = desativado)
+    struct AutoSalvamento *autosave;   // salvamento automático (NULL = desativado)
+    struct Prefetcher *prefetcher;     // pré-carregamento de salas (NULL = desativado)
+} Sessao;
+
+#define MAX_BIFURCACOES 8
+
+#define MAX_JOGADORES 8
+
+// Comandos de um detetive em um tick do modo cooperativo
+enum { CMD_FICAR = '.', CMD_ESQUERDA = 'e', CMD_DIREITA = 'd', CMD_SAIR = 's' };
+
+// Lote de entradas de um tick: é tudo o que precisa ser transmitido, pois a
+// aplicação é determinística e qualquer réplica reconstrói o estado
+typedef struct LoteTick {
+    int tick;
+    int nJogadores;
+    char comandos[MAX_JOGADORES];
+} LoteTick;
+
+// Estado compartilhado do modo cooperativo
+typedef struct EstadoCoop {
+    Room *mansao;
+    int nJogadores;
+    int tick;
+    Room *posicao[MAX_JOGADORES];
+    int ativo[MAX_JOGADORES];
+    int movimentos[MAX_JOGADORES];
+    int pistasEncontradas[MAX_JOGADORES];
+    Caderno *caderno;   // caderno único da equipe
+    struct PoolColeta *coleta;   // threads persistentes da coleta (ver iniciarCoop())
+} EstadoCoop;
+
+#define TAM_BLOCO_DIARIO 4096
+
+#ifdef TEM_IO_URING
+#define URING_BUFFERS 8   // blocos do diário em voo
+#define URING_LOTE 4      // blocos acumulados por submissão
+
+// Anel io_uring mapeado diretamente (sem liburing), com buffers registrados
+// no kernel: cada bloco é escrito com IORING_OP_WRITE_FIXED
+typedef struct AnelUring {
+    int fd;
+    void *mapaSq, *mapaCq;
+    size_t tamMapaSq, tamMapaCq, tamSqes;
+    unsigned *sqCabeca, *sqCauda, *sqMascara, *sqIndices;
+    struct io_uring_sqe *sqes;
+    unsigned *cqCabeca, *cqCauda, *cqMascara;
+    struct io_uring_cqe *cqes;
+    uint8_t *buffers[URING_BUFFERS];
+    size_t tamBuffer;
+    int ocupado[URING_BUFFERS];
+    size_t tamanho[URING_BUFFERS];     // bytes do bloco em voo
+    off_t deslocamento[URING_BUFFERS];
+    int fdDestino[URING_BUFFERS];
+    unsigned naoSubmetidas;
+    unsigned emVoo;
+    long chamadas;                     // io_uring_enter + escritas de recuperação
+} AnelUring;
+#endif
+
+// Diário de comandos: linhas acumuladas e gravadas em blocos comprimidos,
+// pelo anel io_uring quando disponível ou por write(2)
+typedef struct Diario {
+    int fd;
+    off_t deslocamento;          // próxima posição de escrita no arquivo
+    struct AnelUring *anel;      // NULL = write(2) síncrono
+    long chamadasSistema;        // chamadas feitas pelo caminho write(2)
+    long comandos;
+    size_t usado;
+    uint8_t buffer[TAM_BLOCO_DIARIO];
+} Diario;
+
+// Estado do salvamento automático incremental
+typedef struct AutoSalvamento {
+    const char *caminho;
+    FILE *arquivo;
+    int intervalo;            // movimentos entre gravações
+    int deltasDesdeCompleto;
+    int totalSalvo;           // registros do caderno já gravados
+    int movimentoSalvo;
+    int precisaCompleto;
+} AutoSalvamento;
+
+// Pool de nós de tamanho fixo: lajes de TAM_LAJE bytes com os nós lado a lado
+// e uma lista livre intrusiva (o início de um nó livre aponta para o próximo).
+// Não é seguro para uso concorrente. Com --backend nos=malloc cada nó vem
+// direto do malloc (o modo é fixado quando o pool sai do vazio).
+#define TAM_LAJE (16 * 1024)
+enum { NOS_POOL, NOS_MALLOC };
+#define CLASSE_DE_TAMANHO(n) (((n) + 7) & ~(size_t)7)   // múltiplos de 8 bytes
+
+typedef struct Laje {
+    struct Laje *proxima;
+    size_t reservado;                 // mantém os nós alinhados a 16 bytes
+} Laje;
+
+typedef struct PoolNos {
+    size_t tamNo;                     // classe de tamanho dos nós
+    Laje *lajes;
+    char *cursor;                     // próximo nó nunca usado da laje atual
+    char *fimLaje;
+    void *livres;
+    size_t emUso;
+    size_t nLajes;
+    int direto;                       // nós atuais vieram do malloc
+} PoolNos;
+
+// Registro de backends: alternativas de uma mesma estrutura, escolhidas pelo
+// nome no início (--backend <família>=<nome>) e percorridas pelos benchmarks
+typedef struct OpcaoBackend {
+    const char *nome;
+    int valor;
+} OpcaoBackend;
+
+typedef struct FamiliaBackend {
+    const char *nome;
+    const char *descricao;
+    const OpcaoBackend *opcoes;
+    int nOpcoes;
+    int *escolha;                     // global consultada pela estrutura
+} FamiliaBackend;
+
+// Perfilador por amostragem: o tratador de SIGPROF reserva uma amostra com
+// fetch_add (sem travas, seguro em sinais) e marca-a como pronta ao terminar
+#define PERFIL_HZ 997                    // primo: não sincroniza com laços periódicos
+#define PERFIL_PROFUNDIDADE 48
+#define PERFIL_MAX_AMOSTRAS (1 << 15)
+#define PERFIL_QUADROS_DO_SINAL 2        // tratador + trampolim de retorno do sinal
+
+typedef struct AmostraPerfil {
+    atomic_int pronta;
+    int profundidade;
+    void *quadros[PERFIL_PROFUNDIDADE];
+} AmostraPerfil;
+
+typedef struct Perfilador {
+    const char *caminho;
+    AmostraPerfil *amostras;
+    int capacidade;
+    atomic_int proxima;
+    atomic_long descartadas;             // amostras perdidas com o buffer cheio
+} Perfilador;
+
+// Categorias do relatório de memória
+enum {
+    MEM_SALAS, MEM_DICIONARIO, MEM_SESSOES, MEM_CADERNOS, MEM_ENTRADAS_HASH,
+    MEM_SUSPEITOS, MEM_INDICES, MEM_DESCRICOES, MEM_CATEGORIAS
+};
+
+typedef struct UsoMemoria {
+    size_t blocos;     // número de alocações
+    size_t pedido;     // bytes solicitados
+    size_t real;       // bytes efetivamente consumidos (com overhead do alocador)
+} UsoMemoria;
+
+typedef struct RelatorioMemoria {
+    UsoMemoria uso[MEM_CATEGORIAS];
+} RelatorioMemoria;
+
+// Métricas de execução (--metricas <socket>): contadores por CPU, cada fatia
+// em suas próprias linhas de cache, somados apenas quando lidos
+enum {
+    MET_SESSOES_CRIADAS, MET_SESSOES_LIBERADAS, MET_MOVIMENTOS, MET_PISTAS_INSERIDAS,
+    MET_CONSULTAS_HASH, MET_VEREDITOS_VALIDOS, MET_VEREDITOS_FRACOS, MET_BLOCOS_ANTECIPADOS,
+    MET_CONTADORES
+};
+#define MAX_FATIAS_METRICAS 64
+#define MET_FAIXAS_LATENCIA 12      // limites do histograma, de 1 µs a 5 ms
+
+typedef struct FatiaMetricas {
+    _Alignas(64) atomic_ulong contadores[MET_CONTADORES];
+    atomic_ulong latencia[MET_FAIXAS_LATENCIA + 1];   // a última faixa é +Inf
+    atomic_ulong latenciaSomaNs;
+} FatiaMetricas;
+
+// Endpoint das métricas: uma thread aceita conexões no socket Unix
+typedef struct ServidorMetricas {
+    int fd;
+    const char *caminho;
+    pthread_t thread;
+    double inicio;                     // agoraNs() ao ligar
+} ServidorMetricas;
+
+// Associação estática pista -> suspeito usada na montagem do caso
+typedef struct SuspeitoDePista {
+    const char *pista;
+    const char *suspeito;
+} SuspeitoDePista;
+
+// Definição estática de um caso (mistério)
+typedef struct DefCaso {
+    const char *id;
+    const char *titulo;
+    const DefPropriedade *planta;
+    const PistaDeSala *pistas;
+    int nPistas;
+    const SuspeitoDePista *suspeitos;
+    int nSuspeitos;
+    const DescricaoDeSala *descricoes;
+    int nDescricoes;
+} DefCaso;
+
+// Caso carregado: namespace próprio sobre estruturas compartilhadas do pacote
+typedef struct Caso {
+    const DefCaso *def;
+    const char *id;                  // texto do dicionário
+    Propriedade *propriedade;        // compartilhada entre casos com a mesma planta
+    TabelaPistas tabela;
+    IndiceProcedencia procedencia;
+    DescricoesCaso descricoes;
+    unsigned (*idas)[2];             // por sala: movimentos para a esquerda e direita
+} Caso;
+
+// Conjunto de casos carregados no processo
+typedef struct PacoteCasos {
+    Dicionario dic;
+    Caso *casos;
+    int nCasos;
+    Propriedade **propriedades;
+    int nPropriedades;
+    int *tabelaIds;       // endereçamento aberto: posição -> índice do caso (-1 = vazia)
+    int capacidadeIds;
+} PacoteCasos;
+
+// Índice escolhido pelo planejador de consultas
+typedef enum { PLANO_VARREDURA, PLANO_SUSPEITO, PLANO_SALA, PLANO_TEMPO } PlanoConsulta;
+
+// Resultado da conferência de um diário (--reproduzir)
+enum { REPRODUCAO_OK, REPRODUCAO_DIVERGENTE, REPRODUCAO_ERRO, REPRODUCAO_IGNORADA };
+
+typedef struct ResultadoReproducao {
+    int estado;
+    long eventos;          // comandos reproduzidos
+    char detalhe[160];
+} ResultadoReproducao;
+
+// Assinaturas dos arquivos do diário, do jogo salvo e do salvamento automático
+#define MAGICO_DIARIO "DQD1"
+#define MAGICO_SAVE "DQS1"
+#define MAGICO_AUTOSAVE "DQA1"
+#define INTERVALO_AUTOSAVE 2           // movimentos entre gravações automáticas
+
+// Linhas de controle do diário, usadas na reprodução (--reproduzir)
+#define DIARIO_CASO "#caso "           // partida nova do caso
+#define DIARIO_RETOMADO "#retomado "   // partida carregada de um jogo salvo
+#define DIARIO_FIM "#fim "             // movimentos, pistas e resumo do caderno
+
+#define N_ELEMENTOS(v) ((int)(sizeof(v) / sizeof((v)[0])))
+
+/* ----------------------------- auxiliares.c ----------------------------- */
+
+char *strdup_safe(const char *s);
+double agoraNs(void);
+
+/* ----------------------------- metricas.c ----------------------------- */
+
+extern int metricasAtivas;
+
+void contarMetrica(int contador);
+void observarLatencia(double ns);
+void escreverMetricas(FILE *out);
+void encerrarMetricas(void);
+int iniciarMetricas(const char *caminho);
+
+/* ----------------------------- entrada.c ----------------------------- */
+
+extern LeitorEntrada entrada;
+
+int lerLinha(LeitorEntrada *l, VisaoLinha *v);
+int lerLinhaEm(LeitorEntrada *l, char *destino, size_t tam);
+void liberarLeitor(LeitorEntrada *l);
+
+/* ----------------------------- pools.c ----------------------------- */
+
+extern int disposicaoNos;
+extern PoolNos poolEntradasHash;
+extern PoolNos poolSalas;
+
+void *alocarNo(PoolNos *p);
+void liberarNo(PoolNos *p, void *no);
+
+/* ----------------------------- requeridas.c ----------------------------- */
+
+extern int tabelaPistasPadrao;
+
+Room *criarSala(const char *name, int id);
+ClueNode *inserirPista(ClueNode *root, const char *clue);
+int buscarPista(ClueNode *root, const char *clue);
+unsigned int hash_func(const char *s);
+void inicializarTabelaPistas(TabelaPistas *table, int organizacao);
+void inserirNaHash(TabelaPistas *table, const char *pista, const char *suspeito);
+const char *encontrarSuspeito(const TabelaPistas *table, const char *pista);
+
+/* ----------------------------- dicionario.c ----------------------------- */
+
+unsigned int hashTexto(const char *s);
+void inicializarDicionario(Dicionario *d);
+size_t posicaoNoDicionario(const Dicionario *d, const char *texto);
+const char *buscarNoDicionario(const Dicionario *d, const char *texto);
+const char *internar(Dicionario *d, const char *texto);
+void criarMapaTextos(MapaTextos *m, size_t chaves);
+int mapearTexto(MapaTextos *m, const char *chave, int valor);
+int buscarNoMapa(const MapaTextos *m, const char *chave);
+void liberarMapaTextos(MapaTextos *m);
+void liberarDicionario(Dicionario *d);
+
+/* ----------------------------- transmissao.c ----------------------------- */
+
+void liberarBloco(BlocoSaida *b);
+void removerEspectador(Transmissao *tx, int i);
+int abrirEspectador(const char *caminho);
+void enviarEspectadores(Transmissao *tx);
+void distribuirBloco(Transmissao *tx, BlocoSaida *b);
+void emitir(Transmissao *tx, const char *fmt, ...);
+void transmitirEspectadores(Transmissao *tx, const void *dados, size_t tamanho);
+int inscreverEspectador(Transmissao *tx, const char *caminho);
+void encerrarTransmissao(Transmissao *tx);
+
+/* ----------------------------- lz.c ----------------------------- */
+
+size_t limiteLz(size_t n);
+size_t comprimirLz(const uint8_t *src, size_t n, uint8_t *dst);
+long descomprimirLz(const uint8_t *src, size_t n, uint8_t *dst, size_t cap);
+size_t limiteBloco(uint32_t n);
+size_t montarBloco(const void *dados, uint32_t n, uint8_t *saida);
+int gravarBloco(FILE *f, const void *dados, uint32_t n);
+void *lerBloco(FILE *f, uint32_t *n);
+char *abrirBlocoNaMemoria(const uint8_t *p, size_t tam, uint32_t *n);
+
+/* ----------------------------- art.c ----------------------------- */
+
+extern const size_t TAMANHO_NO_ART[];
+
+int ehFolhaArt(const NoArt *n);
+FolhaArt *folhaArt(const NoArt *n);
+int inserirNaRadix(ArvoreRadix *a, const char *pista);
+int buscarNaRadix(const ArvoreRadix *a, const char *pista);
+void percorrerRadix(const NoArt *n, void (*visitar)(const char *pista, void *ctx), void *ctx);
+NoArt **filhosArt(NoArt *n, int *quantidade);
+NoArt *clonarRadix(const NoArt *n);
+void liberarRadix(NoArt *n);
+
+/* ----------------------------- lista_saltos.c ----------------------------- */
+
+void inicializarListaSaltos(ListaSaltos *l);
+NoSaltos *inserirNaListaSaltos(ListaSaltos *l, const char *pista, int *nova);
+int buscarNaListaSaltos(ListaSaltos *l, const char *pista);
+unsigned percorrerListaSaltos(ListaSaltos *l, void (*visitar)(const char *pista, void *ctx), void *ctx);
+void liberarListaSaltos(ListaSaltos *l);
+
+/* ----------------------------- ranking.c ----------------------------- */
+
+uint64_t chaveRanking(uint32_t tempoMs, uint32_t eficiencia);
+RankingGlobal *criarRanking(int maxJogadores);
+int jogadorDoRanking(RankingGlobal *r, const char *nome);
+void atualizarRanking(RankingGlobal *r, int jogador, uint32_t tempoMs, uint32_t eficiencia);
+int primeirosDoRanking(RankingGlobal *r, ItemRanking *saida, int n);
+int posicaoNoRanking(RankingGlobal *r, int jogador);
+int totalDoRanking(RankingGlobal *r);
+void liberarRanking(RankingGlobal *r);
+void registrarResultadoNoRanking(const char *caminho, const char *nome, uint32_t tempoMs,
+                                 uint32_t eficiencia);
+
+/* ----------------------------- placar.c ----------------------------- */
+
+void ajustarPlacar(PlacarSuspeitos *p, int suspeito, int delta);
+PlacarSuspeitos clonarPlacar(const PlacarSuspeitos *p);
+void liberarPlacar(PlacarSuspeitos *p);
+int liderDoPlacar(const PlacarSuspeitos *p);
+int primeirosDoPlacar(const PlacarSuspeitos *p, int *saida, int k);
+
+/* ----------------------------- caderno.c ----------------------------- */
+
+extern int indicePistasPadrao;
+
+void anexarIndice(ListaIndices *l, int pos);
+void inicializarCaderno(Caderno *c);
+int cadernoContemPista(const Caderno *c, const char *clue);
+void percorrerBst(const ClueNode *n, void (*visitar)(const char *pista, void *ctx), void *ctx);
+void percorrerPistas(const Caderno *c, void (*visitar)(const char *pista, void *ctx), void *ctx);
+int procurarSuspeito(const Caderno *c, const char *nome);
+int idSuspeito(Caderno *c, const char *nome);
+ListaIndices *indiceDaSala(Caderno *c, int sala);
+
+/* ----------------------------- linha_tempo.c ----------------------------- */
+
+void anexarEvento(LinhaDoTempo *l, int pista, int movimento);
+int limiteInferiorMovimento(const LinhaDoTempo *l, int mov);
+int ultimasPistas(const LinhaDoTempo *l, int n, const EventoPista **inicio);
+int pistasEntreMovimentos(const LinhaDoTempo *l, int a, int b, const EventoPista **inicio);
+void anexarRegistro(Caderno *c, int pistaId, const char *clue, const Room *sala,
+                    const char *suspeito, int movimento);
+int inserirNoIndiceDePistas(Caderno *c, const char *clue);
+int registrarPista(Caderno *c, int pistaId, const char *clue, const Room *sala,
+                   const char *suspeito, int movimento);
+int registroAtendeFiltro(const RegistroPista *r, const FiltroPistas *f, int suspeito);
+int consultarPistas(const Caderno *c, const FiltroPistas *f,
+                    int *saida, int max, PlanoConsulta *plano);
+Room *buscarSala(Room *r, const char *nome);
+Andar *buscarAndar(Room *r, const char *nome);
+int lerInteiroOpcional(const char *rotulo, int padrao);
+void consultarCaderno(const Caderno *c, Room *mansao, const IndiceProcedencia *proc);
+
+/* ----------------------------- procedencia.c ----------------------------- */
+
+int contarIdsSalas(const Room *r);
+int *alocarInts(int n);
+int contarSalas(const Room *r);
+void mapearSalas(MapaTextos *m, const Room *r);
+void construirProcedencia(IndiceProcedencia *idx, Room *mansao,
+                          const PistaDeSala *defs, int nDefs, Dicionario *dic);
+const int *pistasDaSala(const IndiceProcedencia *idx, int sala, int *n);
+const int *salasDaPista(const IndiceProcedencia *idx, int pista, int *n);
+int idPista(const IndiceProcedencia *idx, const char *pista);
+void freeProcedencia(IndiceProcedencia *idx);
+void mostrarHistorico(const LinhaDoTempo *l, const IndiceProcedencia *proc);
+
+/* ----------------------------- descricoes.c ----------------------------- */
+
+void inicializarDescricoes(DescricoesCaso *d, int nSalas);
+void fecharBlocoDescricoes(DescricoesCaso *d);
+void adicionarDescricao(DescricoesCaso *d, int sala, const char *texto);
+void finalizarDescricoes(DescricoesCaso *d);
+void construirDescricoes(DescricoesCaso *d, Room *mansao, const DescricaoDeSala *defs, int n);
+const char *descricaoDaSala(DescricoesCaso *d, int sala);
+void liberarDescricoes(DescricoesCaso *d);
+void *executarPrefetcher(void *arg);
+Prefetcher *iniciarPrefetcher(DescricoesCaso *d);
+void anteciparSalas(Prefetcher *pf, const int *salas, int n);
+void encerrarPrefetcher(Prefetcher *pf);
+void registrarIda(Caso *caso, const Room *de, const Room *para);
+int preverSalas(const Caso *caso, const Room *sala, int *saida, int max);
+
+/* ----------------------------- sessoes.c ----------------------------- */
+
+Caderno *criarCaderno(void);
+ClueNode *clonarPistas(const ClueNode *n);
+void *duplicarMemoria(const void *origem, size_t bytes);
+ListaIndices clonarLista(const ListaIndices *l);
+void copiarParaListaSaltos(const char *pista, void *destino);
+Caderno *clonarCaderno(const Caderno *c);
+void liberarCaderno(Caderno *c);
+Sessao *criarSessao(Room *mansao);
+Sessao *bifurcarSessao(const Sessao *s);
+Caderno *cadernoParaEscrita(Sessao *s);
+void liberarSessao(Sessao *s);
+void adicionarPista(Transmissao *tx, Sessao *s, int pistaId, const char *clue,
+                    TabelaPistas *table);
+void mostrarPlacar(Transmissao *tx, const Caderno *c);
+
+/* ----------------------------- memoria.c ----------------------------- */
+
+extern atomic_size_t memoriaPublicada[MEM_CATEGORIAS];
+extern const char *NOMES_CATEGORIAS_MEMORIA[MEM_CATEGORIAS];
+
+void contabilizar(RelatorioMemoria *rel, int categoria, const void *p, size_t pedido);
+void contabilizarNo(RelatorioMemoria *rel, int categoria, const PoolNos *pool, const void *no, size_t pedido);
+void medirPropriedade(RelatorioMemoria *rel, const Propriedade *prop);
+void medirPistas(RelatorioMemoria *rel, const ClueNode *n);
+void medirRadix(RelatorioMemoria *rel, NoArt *n);
+void medirListaSaltos(RelatorioMemoria *rel, const ListaSaltos *l);
+void medirCaderno(RelatorioMemoria *rel, const Caderno *c);
+void medirSessao(RelatorioMemoria *rel, const Sessao *s);
+void medirHash(RelatorioMemoria *rel, const TabelaPistas *table);
+void medirDicionario(RelatorioMemoria *rel, const Dicionario *d);
+void medirProcedencia(RelatorioMemoria *rel, const IndiceProcedencia *idx);
+int larguraUtf8(const char *s);
+void imprimirRelatorioMemoria(FILE *out, const RelatorioMemoria *rel);
+void medirDescricoes(RelatorioMemoria *rel, const DescricoesCaso *d);
+void medirMemoria(RelatorioMemoria *rel, const Sessao *s, TabelaPistas *table, const IndiceProcedencia *proc);
+void mostrarMemoria(const Sessao *s, TabelaPistas *table, const IndiceProcedencia *proc);
+void publicarMemoria(const Sessao *s, TabelaPistas *table, const IndiceProcedencia *proc);
+
+/* ----------------------------- uring.c ----------------------------- */
+
+AnelUring *criarAnelUring(size_t tamBuffer);
+int bufferLivreUring(AnelUring *a);
+void enviarUring(AnelUring *a, int i, int fd, size_t tamanho, off_t deslocamento);
+void drenarUring(AnelUring *a);
+void liberarAnelUring(AnelUring *a);
+
+/* ----------------------------- diario.c ----------------------------- */
+
+extern int usarIoUring;
+
+Diario *abrirDiario(const char *caminho);
+void descarregarDiario(Diario *d);
+long chamadasDoDiario(const Diario *d);
+void registrarComando(Diario *d, const char *linha);
+void fecharDiario(Diario *d);
+uint32_t resumoDoCaderno(const Caderno *c);
+void registrarControleDiario(Diario *d, const char *prefixo, const Sessao *s);
+void serializarInt(uint8_t **p, int32_t v);
+int32_t desserializarInt(const uint8_t **p);
+void serializarVarint(uint8_t **p, uint32_t v);
+int desserializarVarint(const uint8_t **p, const uint8_t *fim, uint32_t *v);
+uint8_t *serializarJogo(const Sessao *s, size_t reserva, size_t *tam);
+int gravarJogo(const Sessao *s, const char *caminho);
+AutoSalvamento *criarAutoSalvamento(const char *caminho, int intervalo);
+int gravarCheckpoint(AutoSalvamento *a, const Sessao *s);
+int gravarDelta(AutoSalvamento *a, const Sessao *s);
+void autoSalvar(AutoSalvamento *a, const Sessao *s, int forcar);
+void encerrarAutoSalvamento(AutoSalvamento *a);
+void salvarJogoInterativo(const Sessao *s);
+
+/* ----------------------------- jogo.c ----------------------------- */
+
+void explorarSalas(Sessao *s, TabelaPistas *table,
+                   const IndiceProcedencia *proc, Transmissao *tx);
+void contarSeDoSuspeito(const char *pista, void *ctx);
+int count_clues_for_suspect(const Caderno *caderno, TabelaPistas *table, const char *suspect);
+void imprimirPista(const char *pista, void *ctx);
+void listarPistas(const Caderno *caderno);
+int verificarSuspeitoFinal(const Caderno *collected, TabelaPistas *table);
+
+/* ----------------------------- coop.c ----------------------------- */
+
+void coletarPistasCoop(EstadoCoop *e, int jogador, TabelaPistas *table,
+                       const IndiceProcedencia *proc);
+void coletarTick(EstadoCoop *e, const int moveu[], TabelaPistas *table,
+                 const IndiceProcedencia *proc);
+void iniciarCoop(EstadoCoop *e, Room *mansao, int nJogadores);
+void encerrarCoop(EstadoCoop *e);
+void aplicarTick(EstadoCoop *e, const LoteTick *lote, TabelaPistas *table,
+                 const IndiceProcedencia *proc);
+int codificarLote(const LoteTick *lote, char *buf, size_t tam);
+void explorarCoop(EstadoCoop *e, TabelaPistas *table, const IndiceProcedencia *proc,
+                  Transmissao *tx);
+
+/* ----------------------------- cenario.c ----------------------------- */
+
+extern const DefCaso CASOS[];
+extern const int N_CASOS;
+
+Room *buscarSalaNoPredio(Predio *p, const char *nome);
+void ligarAcesso(Andar *andar, Room *entrada);
+void carregarAndar(Andar *andar);
+void descarregarAndar(Andar *andar);
+Propriedade *construirPropriedade(const DefPropriedade *def, Dicionario *dic);
+Room *entradaPropriedade(const Propriedade *prop);
+void popularTabelaHash(TabelaPistas *table, const SuspeitoDePista *defs, int n, Dicionario *dic);
+
+/* ----------------------------- pacote.c ----------------------------- */
+
+Propriedade *propriedadeCompartilhada(PacoteCasos *pc, const DefPropriedade *def);
+PacoteCasos *carregarPacote(const DefCaso *defs, int n);
+Caso *buscarCaso(PacoteCasos *pc, const char *id);
+Room *buscarSalaPorId(Room *r, int id);
+Sessao *restaurarJogo(PacoteCasos *pc, const uint8_t *p, size_t tam);
+int aplicarDelta(Sessao *s, const uint8_t *p, size_t tam);
+Sessao *carregarJogo(PacoteCasos *pc, const char *caminho);
+
+/* ----------------------------- reproducao.c ----------------------------- */
+
+void reproduzirDiario(PacoteCasos *pc, const char *caminho, ResultadoReproducao *res);
+void *trabalharReproducao(void *arg);
+int executarReproducoes(PacoteCasos *pc, const char **caminhos, int n);
+
+/* ----------------------------- limpeza.c ----------------------------- */
+
+void liberarPropriedade(Propriedade *prop);
+void freeClues(ClueNode *n);
+void freeCaderno(Caderno *c);
+void freeHash(TabelaPistas *table);
+void liberarPacote(PacoteCasos *pc);
+
+/* ----------------------------- perfil.c ----------------------------- */
+
+void encerrarPerfil(void);
+int iniciarPerfil(const char *caminho);
+
+/* ----------------------------- backends.c ----------------------------- */
+
+const FamiliaBackend *buscarFamiliaBackend(const char *nome);
+const char *backendEmUso(const FamiliaBackend *f);
+void escreverBackendsEmUso(FILE *out);
+void listarBackends(FILE *out);
+int selecionarBackend(const char *especificacao);
+
+/* ----------------------------- bench.c ----------------------------- */
+
+extern volatile uintptr_t benchSumidouro;
+
+uint64_t proximoAleatorio(uint64_t *estado);
+void gerarChavesBench(uint64_t *semente);
+double benchConsultaHash(Caso *caso, uint64_t *semente);
+double benchInsercaoCaderno(Caso *caso, uint64_t *semente);
+double benchBuscaCaderno(Caso *caso, uint64_t *semente);
+double benchPlacar(Caso *caso, uint64_t *semente);
+double benchRankingAtualizacao(Caso *caso, uint64_t *semente);
+double benchRankingPosicao(Caso *caso, uint64_t *semente);
+double benchNos(Caso *caso, uint64_t *semente);
+void medirEspalhamentoNos(uint64_t *semente);
+double benchCaminhada(Caso *caso, uint64_t *semente);
+Sessao *simularPartida(Caso *caso, uint64_t *semente);
+double benchPartida(Caso *caso, uint64_t *semente);
+FILE *roteiroBench(uint64_t *semente);
+double benchLeituraFgets(Caso *caso, uint64_t *semente);
+double benchLeituraBlocos(Caso *caso, uint64_t *semente);
+double escreverDiarioBench(int uring, uint64_t *semente, double *chamadas);
+double benchDiarioWrite(Caso *caso, uint64_t *semente);
+double benchDiarioUring(Caso *caso, uint64_t *semente);
+DescricoesCaso *descricoesBench(uint64_t *semente, size_t *bytesTexto);
+double benchDescricao(Caso *caso, uint64_t *semente);
+double benchVisitaSemPrefetch(Caso *caso, uint64_t *semente);
+double benchVisitaComPrefetch(Caso *caso, uint64_t *semente);
+int executarBenchmarks(PacoteCasos *pc, const char *caminho);
+
+#endif
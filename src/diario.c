@@ -0,0 +1,280 @@
+#include "detective.h"
+
+/* ----------------------------- Diário e jogos salvos ----------------------------- */
+
+#define ARQUIVO_SAVE_PADRAO "detective_quest.sav"
+
+// Backend de escrita do diário: io_uring quando disponível (--sem-uring desativa)
+int usarIoUring = 1;
+
+Diario *abrirDiario(const char *caminho) {
+    int fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { perror(caminho); return NULL; }
+    Diario *d = malloc(sizeof(Diario));
+    if (!d) { perror("malloc"); exit(EXIT_FAILURE); }
+    d->fd = fd;
+    d->anel = NULL;
+#ifdef TEM_IO_URING
+    if (usarIoUring) d->anel = criarAnelUring(limiteBloco(TAM_BLOCO_DIARIO));
+#endif
+    d->chamadasSistema = 1;
+    d->comandos = 0;
+    d->usado = 0;
+    d->deslocamento = write(fd, MAGICO_DIARIO, 4) == 4 ? 4 : 0;
+    if (d->deslocamento == 0) perror("diário");
+    return d;
+}
+
+// Grava o bloco pendente: no anel io_uring sem esperar a conclusão, ou por write(2)
+void descarregarDiario(Diario *d) {
+    if (!d || d->usado == 0) return;
+#ifdef TEM_IO_URING
+    if (d->anel) {
+        int i = bufferLivreUring(d->anel);
+        size_t tam = montarBloco(d->buffer, (uint32_t)d->usado, d->anel->buffers[i]);
+        enviarUring(d->anel, i, d->fd, tam, d->deslocamento);
+        d->deslocamento += (off_t)tam;
+        d->usado = 0;
+        return;
+    }
+#endif
+    uint8_t bloco[8 + TAM_BLOCO_DIARIO + TAM_BLOCO_DIARIO / 255 + 16];   // limiteBloco()
+    size_t tam = montarBloco(d->buffer, (uint32_t)d->usado, bloco), feito = 0;
+    while (feito < tam) {
+        d->chamadasSistema++;
+        ssize_t n = write(d->fd, bloco + feito, tam - feito);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) { perror("diário"); break; }
+        feito += (size_t)n;
+    }
+    d->deslocamento += (off_t)tam;
+    d->usado = 0;
+}
+
+// Chamadas de sistema feitas até agora para gravar o diário
+long chamadasDoDiario(const Diario *d) {
+#ifdef TEM_IO_URING
+    if (d->anel) return d->chamadasSistema + d->anel->chamadas;
+#endif
+    return d->chamadasSistema;
+}
+
+/**
+ * registrarComando()
+ * Acrescenta uma linha de comando ao diário. O buffer é comprimido e gravado
+ * como um bloco quando enche (e ao fechar o diário).
+ */
+void registrarComando(Diario *d, const char *linha) {
+    if (!d) return;
+    size_t n = strlen(linha);
+    if (n + 1 > TAM_BLOCO_DIARIO) n = TAM_BLOCO_DIARIO - 1;
+    if (d->usado + n + 1 > TAM_BLOCO_DIARIO) descarregarDiario(d);
+    memcpy(d->buffer + d->usado, linha, n);
+    d->buffer[d->usado + n] = '\n';
+    d->usado += n + 1;
+    d->comandos++;
+}
+
+void fecharDiario(Diario *d) {
+    if (!d) return;
+    descarregarDiario(d);
+#ifdef TEM_IO_URING
+    liberarAnelUring(d->anel);
+#endif
+    close(d->fd);
+    free(d);
+}
+
+/**
+ * resumoDoCaderno()
+ * Resumo FNV-1a dos registros do caderno em ordem de descoberta (pista, sala e
+ * movimento), gravado no fim do diário para conferir reproduções.
+ */
+uint32_t resumoDoCaderno(const Caderno *c) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < c->total; i++) {
+        const RegistroPista *r = &c->registros[i];
+        for (const char *p = r->pista; *p; p++) h = (h ^ (uint8_t)*p) * 16777619u;
+        int32_t campos[2] = { r->sala, r->movimento };
+        const uint8_t *bytes = (const uint8_t*)campos;
+        for (size_t k = 0; k < sizeof(campos); k++) h = (h ^ bytes[k]) * 16777619u;
+    }
+    return h;
+}
+
+// Grava a linha de controle inicial ou final da partida no diário
+void registrarControleDiario(Diario *d, const char *prefixo, const Sessao *s) {
+    if (!d) return;
+    char linha[MAX_INPUT];
+    if (strcmp(prefixo, DIARIO_FIM) == 0)
+        snprintf(linha, sizeof(linha), "%s%d %d %08x", prefixo, s->movimento, s->caderno->total,
+                 (unsigned)resumoDoCaderno(s->caderno));
+    else
+        snprintf(linha, sizeof(linha), "%s%s", prefixo, s->caso->def->id);
+    registrarComando(d, linha);
+}
+
+// Acrescenta um inteiro de 32 bits ao buffer de serialização
+void serializarInt(uint8_t **p, int32_t v) {
+    memcpy(*p, &v, 4);
+    *p += 4;
+}
+
+int32_t desserializarInt(const uint8_t **p) {
+    int32_t v;
+    memcpy(&v, *p, 4);
+    *p += 4;
+    return v;
+}
+
+// Inteiro sem sinal em base 128 (1 byte para valores < 128)
+void serializarVarint(uint8_t **p, uint32_t v) {
+    while (v >= 0x80) { *(*p)++ = (uint8_t)(v | 0x80); v >>= 7; }
+    *(*p)++ = (uint8_t)v;
+}
+
+// Retorna 0 em caso de sucesso e -1 se o buffer terminar no meio do número
+int desserializarVarint(const uint8_t **p, const uint8_t *fim, uint32_t *v) {
+    *v = 0;
+    for (int desloc = 0; desloc < 35; desloc += 7) {
+        if (*p >= fim) return -1;
+        uint8_t b = *(*p)++;
+        *v |= (uint32_t)(b & 0x7F) << desloc;
+        if (!(b & 0x80)) return 0;
+    }
+    return -1;
+}
+
+/**
+ * serializarJogo()
+ * Codifica o estado completo da sessão (caso, sala atual, movimento e pistas
+ * coletadas com sala e movimento da descoberta). Os primeiros `reserva` bytes
+ * do buffer ficam livres para o chamador. Retorna o buffer (liberar com free).
+ */
+uint8_t *serializarJogo(const Sessao *s, size_t reserva, size_t *tam) {
+    const Caderno *c = s->caderno;
+    size_t tamId = strlen(s->caso->id);
+    *tam = reserva + 4 + tamId + 4 * 3 + (size_t)c->total * 12;
+    uint8_t *buf = malloc(*tam), *p = buf + reserva;
+    if (!buf) { perror("malloc"); exit(EXIT_FAILURE); }
+
+    serializarInt(&p, (int32_t)tamId);
+    memcpy(p, s->caso->id, tamId);
+    p += tamId;
+    serializarInt(&p, s->atual->id);
+    serializarInt(&p, s->movimento);
+    serializarInt(&p, c->total);
+    for (int i = 0; i < c->total; i++) {
+        serializarInt(&p, c->linha.eventos[i].pista);
+        serializarInt(&p, c->registros[i].sala);
+        serializarInt(&p, c->registros[i].movimento);
+    }
+    return buf;
+}
+
+/**
+ * gravarJogo()
+ * Salva a sessão em um único bloco comprimido.
+ * Retorna 0 em caso de sucesso e -1 em caso de erro.
+ */
+int gravarJogo(const Sessao *s, const char *caminho) {
+    size_t tam;
+    uint8_t *buf = serializarJogo(s, 0, &tam);
+    FILE *f = fopen(caminho, "wb");
+    int ok = f && fwrite(MAGICO_SAVE, 4, 1, f) == 1 && gravarBloco(f, buf, (uint32_t)tam) == 0;
+    if (!f) perror(caminho);
+    else if (fclose(f) != 0) ok = 0;
+    free(buf);
+    return ok ? 0 : -1;
+}
+
+/*
+ Salvamento automático incremental: o arquivo começa com um checkpoint completo
+ ('F' + estado de serializarJogo) seguido de deltas ('D'), cada um em seu bloco.
+ Um delta contém apenas a sala atual, o avanço do contador de movimentos e as
+ pistas coletadas desde a gravação anterior, tudo em varints.
+*/
+#define DELTAS_POR_CHECKPOINT 16
+
+AutoSalvamento *criarAutoSalvamento(const char *caminho, int intervalo) {
+    AutoSalvamento *a = calloc(1, sizeof(AutoSalvamento));
+    if (!a) { perror("calloc"); exit(EXIT_FAILURE); }
+    a->caminho = caminho;
+    a->intervalo = intervalo > 0 ? intervalo : 1;
+    a->precisaCompleto = 1;
+    return a;
+}
+
+// Reescreve o arquivo com um checkpoint completo
+int gravarCheckpoint(AutoSalvamento *a, const Sessao *s) {
+    size_t tam;
+    uint8_t *buf = serializarJogo(s, 1, &tam);
+    buf[0] = 'F';
+    if (a->arquivo) fclose(a->arquivo);
+    a->arquivo = fopen(a->caminho, "wb");
+    int ok = a->arquivo && fwrite(MAGICO_AUTOSAVE, 4, 1, a->arquivo) == 1 &&
+             gravarBloco(a->arquivo, buf, (uint32_t)tam) == 0 && fflush(a->arquivo) == 0;
+    free(buf);
+    a->deltasDesdeCompleto = 0;
+    return ok ? 0 : -1;
+}
+
+// Acrescenta um delta com o que mudou desde a última gravação
+int gravarDelta(AutoSalvamento *a, const Sessao *s) {
+    const Caderno *c = s->caderno;
+    int novas = c->total - a->totalSalvo;
+    uint8_t *buf = malloc(1 + 5 * 3 + (size_t)novas * 15), *p = buf;
+    if (!buf) { perror("malloc"); exit(EXIT_FAILURE); }
+    *p++ = 'D';
+    serializarVarint(&p, (uint32_t)s->atual->id);
+    serializarVarint(&p, (uint32_t)(s->movimento - a->movimentoSalvo));
+    serializarVarint(&p, (uint32_t)novas);
+    int anterior = a->movimentoSalvo;
+    for (int i = a->totalSalvo; i < c->total; i++) {
+        serializarVarint(&p, (uint32_t)c->linha.eventos[i].pista);
+        serializarVarint(&p, (uint32_t)c->registros[i].sala);
+        serializarVarint(&p, (uint32_t)(c->registros[i].movimento - anterior));
+        anterior = c->registros[i].movimento;
+    }
+    int ok = gravarBloco(a->arquivo, buf, (uint32_t)(p - buf)) == 0 && fflush(a->arquivo) == 0;
+    free(buf);
+    a->deltasDesdeCompleto++;
+    return ok ? 0 : -1;
+}
+
+/**
+ * autoSalvar()
+ * Chamada após cada movimento: a cada `intervalo` movimentos (ou sempre, com
+ * `forcar`, p. ex. ao encerrar a exploração) grava um delta,
+ * e a cada DELTAS_POR_CHECKPOINT deltas (ou quando o caderno deixou de ser
+ * uma extensão do que foi salvo, p. ex. após voltar a um ponto marcado)
+ * reescreve o arquivo com um checkpoint completo.
+ */
+void autoSalvar(AutoSalvamento *a, const Sessao *s, int forcar) {
+    if (!a) return;
+    if (!a->precisaCompleto && s->movimento - a->movimentoSalvo < a->intervalo &&
+        !(forcar && (s->movimento != a->movimentoSalvo || s->caderno->total != a->totalSalvo))) return;
+    int completo = a->precisaCompleto || !a->arquivo || a->deltasDesdeCompleto >= DELTAS_POR_CHECKPOINT ||
+                   s->caderno->total < a->totalSalvo || s->movimento < a->movimentoSalvo;
+    int r = completo ? gravarCheckpoint(a, s) : gravarDelta(a, s);
+    if (r != 0) { perror(a->caminho); return; }
+    a->precisaCompleto = 0;
+    a->totalSalvo = s->caderno->total;
+    a->movimentoSalvo = s->movimento;
+}
+
+void encerrarAutoSalvamento(AutoSalvamento *a) {
+    if (!a) return;
+    if (a->arquivo) fclose(a->arquivo);
+    free(a);
+}
+
+// Pergunta o arquivo e salva o jogo
+void salvarJogoInterativo(const Sessao *s) {
+    char caminho[MAX_INPUT];
+    printf("Arquivo (vazio = %s): ", ARQUIVO_SAVE_PADRAO);
+    if (!lerLinhaEm(&entrada, caminho, sizeof(caminho))) return;
+    if (strlen(caminho) == 0) strcpy(caminho, ARQUIVO_SAVE_PADRAO);
+    if (gravarJogo(s, caminho) == 0) printf("Jogo salvo em %s.\n\n", caminho);
+    else printf("Não foi possível salvar o jogo.\n\n");
+}
@@ -0,0 +1,104 @@
+#include "detective.h"
+
+/* ----------------------------- Dicionário compartilhado ----------------------------- */
+
+// Hash de 32 bits (djb2) sem redução ao tamanho da tabela
+unsigned int hashTexto(const char *s) {
+    unsigned int h = 5381;
+    while (*s) h = ((h << 5) + h) + (unsigned char)(*s++);
+    return h;
+}
+
+void inicializarDicionario(Dicionario *d) {
+    d->capacidade = 64;
+    d->total = 0;
+    d->textos = calloc(d->capacidade, sizeof(char*));
+    if (!d->textos) { perror("calloc"); exit(EXIT_FAILURE); }
+}
+
+// Posição do texto na tabela, ou da vaga onde ele entraria
+size_t posicaoNoDicionario(const Dicionario *d, const char *texto) {
+    size_t mascara = d->capacidade - 1;
+    size_t i = hashTexto(texto) & mascara;
+    while (d->textos[i] && strcmp(d->textos[i], texto) != 0) i = (i + 1) & mascara;
+    return i;
+}
+
+/**
+ * buscarNoDicionario()
+ * Retorna o texto canônico igual a `texto`, ou NULL se ele nunca foi internado.
+ */
+const char *buscarNoDicionario(const Dicionario *d, const char *texto) {
+    return d->textos[posicaoNoDicionario(d, texto)];
+}
+
+/**
+ * internar()
+ * Retorna o texto canônico igual a `texto`, copiando-o para o dicionário na
+ * primeira ocorrência. Textos iguais passam a ser comparáveis por ponteiro.
+ */
+const char *internar(Dicionario *d, const char *texto) {
+    if (!texto) return NULL;
+    size_t i = posicaoNoDicionario(d, texto);
+    if (d->textos[i]) return d->textos[i];
+
+    if ((d->total + 1) * 10 > d->capacidade * 7) {
+        // ocupação acima de 70%: dobra a tabela e reinsere
+        Dicionario maior = { calloc(d->capacidade * 2, sizeof(char*)), d->capacidade * 2, d->total };
+        if (!maior.textos) { perror("calloc"); exit(EXIT_FAILURE); }
+        for (size_t k = 0; k < d->capacidade; k++)
+            if (d->textos[k]) maior.textos[posicaoNoDicionario(&maior, d->textos[k])] = d->textos[k];
+        free(d->textos);
+        *d = maior;
+        i = posicaoNoDicionario(d, texto);
+    }
+    d->textos[i] = strdup_safe(texto);
+    d->total++;
+    return d->textos[i];
+}
+
+void criarMapaTextos(MapaTextos *m, size_t chaves) {
+    m->capacidade = 4;
+    while (m->capacidade < 2 * chaves) m->capacidade *= 2;
+    m->chaves = calloc(m->capacidade, sizeof(char*));
+    m->valores = malloc(m->capacidade * sizeof(int));
+    if (!m->chaves || !m->valores) { perror("malloc"); exit(EXIT_FAILURE); }
+}
+
+/**
+ * mapearTexto()
+ * Associa `valor` ao texto internado `chave`, se ela ainda não estiver no mapa.
+ * Retorna o valor associado (o já existente, se houver). O mapa não cresce:
+ * deve ser criado com espaço para todas as chaves.
+ */
+int mapearTexto(MapaTextos *m, const char *chave, int valor) {
+    size_t mascara = m->capacidade - 1;
+    size_t k = hashTexto(chave) & mascara;
+    while (m->chaves[k] && m->chaves[k] != chave) k = (k + 1) & mascara;
+    if (!m->chaves[k]) {
+        m->chaves[k] = chave;
+        m->valores[k] = valor;
+    }
+    return m->valores[k];
+}
+
+// Valor do texto internado `chave`, ou -1 se ausente
+int buscarNoMapa(const MapaTextos *m, const char *chave) {
+    if (!chave || m->capacidade == 0) return -1;
+    size_t mascara = m->capacidade - 1;
+    for (size_t k = hashTexto(chave) & mascara; m->chaves[k]; k = (k + 1) & mascara)
+        if (m->chaves[k] == chave) return m->valores[k];
+    return -1;
+}
+
+void liberarMapaTextos(MapaTextos *m) {
+    free(m->chaves);
+    free(m->valores);
+    memset(m, 0, sizeof(*m));
+}
+
+void liberarDicionario(Dicionario *d) {
+    for (size_t i = 0; i < d->capacidade; i++) free(d->textos[i]);
+    free(d->textos);
+    memset(d, 0, sizeof(*d));
+}
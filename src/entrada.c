@@ -0,0 +1,87 @@
+#include "detective.h"
+
+/* ----------------------------- Leitura da entrada ----------------------------- */
+
+// Entrada padrão do jogo; todas as leituras de comandos e respostas passam por aqui
+LeitorEntrada entrada = { STDIN_FILENO, NULL, 0, 0, 0, 0 };
+
+// Primeiro '\n' em [p, p + n), comparando 32 bytes por iteração com SSE2
+static char *procurarQuebraDeLinha(char *p, size_t n) {
+#ifdef __SSE2__
+    const __m128i quebra = _mm_set1_epi8('\n');
+    while (n >= 32) {
+        __m128i a = _mm_loadu_si128((const __m128i*)p);
+        __m128i b = _mm_loadu_si128((const __m128i*)(p + 16));
+        unsigned ma = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, quebra));
+        unsigned mb = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(b, quebra));
+        if (ma | mb) return p + __builtin_ctz(ma | (mb << 16));
+        p += 32;
+        n -= 32;
+    }
+#endif
+    return memchr(p, '\n', n);
+}
+
+/**
+ * lerLinha()
+ * Entrega a próxima linha como visão sobre o buffer do leitor, lendo do
+ * descritor em blocos de TAM_BLOCO_ENTRADA. Linhas maiores que o buffer o
+ * fazem crescer. Retorna 0 no fim da entrada.
+ */
+int lerLinha(LeitorEntrada *l, VisaoLinha *v) {
+    if (!l->buffer) {
+        l->capacidade = TAM_BLOCO_ENTRADA;
+        l->buffer = malloc(l->capacidade + 1);
+        if (!l->buffer) { perror("malloc"); exit(EXIT_FAILURE); }
+    }
+    size_t varrido = l->inicio;
+    for (;;) {
+        char *quebra = procurarQuebraDeLinha(l->buffer + varrido, l->fim - varrido);
+        if (quebra || (l->eof && l->inicio < l->fim)) {
+            if (!quebra) quebra = l->buffer + l->fim;   // última linha sem '\n'
+            *quebra = '\0';
+            v->texto = l->buffer + l->inicio;
+            v->tamanho = (size_t)(quebra - v->texto);
+            l->inicio = (size_t)(quebra - l->buffer) + 1;
+            if (l->inicio > l->fim) l->inicio = l->fim;
+            return 1;
+        }
+        if (l->eof) return 0;
+        varrido = l->fim;
+
+        // descarta as linhas já entregues e completa o buffer
+        if (l->inicio > 0) {
+            memmove(l->buffer, l->buffer + l->inicio, l->fim - l->inicio);
+            l->fim -= l->inicio;
+            varrido -= l->inicio;
+            l->inicio = 0;
+        }
+        if (l->fim == l->capacidade) {
+            char *maior = realloc(l->buffer, l->capacidade * 2 + 1);
+            if (!maior) { perror("realloc"); exit(EXIT_FAILURE); }
+            l->buffer = maior;
+            l->capacidade *= 2;
+        }
+        fflush(stdout);   // o prompt precisa aparecer antes de bloquear na leitura
+        ssize_t n = read(l->fd, l->buffer + l->fim, l->capacidade - l->fim);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) l->eof = 1;
+        else l->fim += (size_t)n;
+    }
+}
+
+// Lê a próxima linha copiando-a para `destino` (truncada em tam - 1 bytes)
+int lerLinhaEm(LeitorEntrada *l, char *destino, size_t tam) {
+    VisaoLinha v;
+    if (!lerLinha(l, &v)) return 0;
+    size_t n = v.tamanho < tam - 1 ? v.tamanho : tam - 1;
+    memcpy(destino, v.texto, n);
+    destino[n] = '\0';
+    return 1;
+}
+
+void liberarLeitor(LeitorEntrada *l) {
+    free(l->buffer);
+    l->buffer = NULL;
+    l->capacidade = l->inicio = l->fim = 0;
+}
@@ -0,0 +1,180 @@
+#include "detective.h"
+
+/* ----------------------------- Exploração ----------------------------- */
+
+/**
+ * explorarSalas()
+ * Navega pela árvore de cômodos de forma interativa.
+ * Ao visitar um cômodo, identifica as pistas associadas (se houver) pelo índice
+ * de procedência e as coleta automaticamente.
+ * Cada deslocamento conta como um movimento, usado para datar as pistas.
+ * A narrativa da sessão é transmitida aos espectadores inscritos em `tx`.
+ * Pontos de retorno são bifurcações da sessão: voltar descarta o ramo atual.
+ */
+void explorarSalas(Sessao *s, TabelaPistas *table,
+                   const IndiceProcedencia *proc, Transmissao *tx) {
+    Sessao *bifurcacoes[MAX_BIFURCACOES];
+    int nBifurcacoes = 0;
+    const Room *examinada = NULL;   // sala cujas pistas já foram examinadas
+    VisaoLinha linha;
+    double inicioComando = 0;       // latência medida da leitura do comando até o próximo prompt
+
+    emitir(tx, "\n--- Início da exploração da mansão ---\n");
+    while (s->atual) {
+        emitir(tx, "Você está na sala: %s\n", s->atual->name);
+        // descrição e pistas da sala via índice de procedência (apenas ao chegar)
+        if (s->atual != examinada) {
+            const char *descricao = s->caso ? descricaoDaSala(&s->caso->descricoes, s->atual->id) : NULL;
+            if (descricao) emitir(tx, "\n%s\n", descricao);
+            int nPistas;
+            const int *pistas = pistasDaSala(proc, s->atual->id, &nPistas);
+            for (int i = 0; i < nPistas; i++)
+                adicionarPista(tx, s, pistas[i], proc->pistas[pistas[i]], table);
+            if (nPistas == 0) emitir(tx, "Não há pistas aparentes nesta sala.\n\n");
+            examinada = s->atual;
+            autoSalvar(s->autosave, s, 0);
+            publicarMemoria(s, table, proc);
+        }
+
+        // controle de navegação
+        emitir(tx, "Escolha: (e) esquerdo, (d) direito, (c) consultar pistas, (h) histórico,\n"
+                   "         (m) marcar ponto de retorno, (v) voltar ao ponto marcado, (r) relatório de memória,\n"
+                   "         (g) gravar jogo, (p) placar de suspeitos, (s) sair da exploração\n");
+        emitir(tx, "> ");
+        enviarEspectadores(tx);
+        if (s->prefetcher) {
+            int provaveis[MAX_PREFETCH];
+            anteciparSalas(s->prefetcher, provaveis, preverSalas(s->caso, s->atual, provaveis, MAX_PREFETCH));
+        }
+        if (inicioComando > 0) observarLatencia(agoraNs() - inicioComando);
+        if (!lerLinha(&entrada, &linha)) { inicioComando = 0; break; }
+        if (metricasAtivas) inicioComando = agoraNs();
+        registrarComando(s->diario, linha.texto);
+        if (linha.tamanho == 0) continue;
+        char c = linha.texto[0];
+        if (c == 'e' || c == 'E') {
+            if (s->atual->left) {
+                registrarIda(s->caso, s->atual, s->atual->left);
+                s->atual = s->atual->left;
+                s->movimento++;
+                contarMetrica(MET_MOVIMENTOS);
+            } else emitir(tx, "Não há sala à esquerda.\n\n");
+        } else if (c == 'd' || c == 'D') {
+            if (s->atual->right) {
+                registrarIda(s->caso, s->atual, s->atual->right);
+                s->atual = s->atual->right;
+                s->movimento++;
+                contarMetrica(MET_MOVIMENTOS);
+            } else emitir(tx, "Não há sala à direita.\n\n");
+        } else if (c == 'c' || c == 'C') {
+            consultarCaderno(s->caderno, s->mansao, proc);
+        } else if (c == 'h' || c == 'H') {
+            mostrarHistorico(&s->caderno->linha, proc);
+        } else if (c == 'm' || c == 'M') {
+            if (nBifurcacoes == MAX_BIFURCACOES) {
+                emitir(tx, "Limite de pontos de retorno atingido.\n\n");
+            } else {
+                bifurcacoes[nBifurcacoes++] = bifurcarSessao(s);
+                emitir(tx, "Ponto de retorno marcado em %s.\n\n", s->atual->name);
+            }
+        } else if (c == 'v' || c == 'V') {
+            if (nBifurcacoes == 0) {
+                emitir(tx, "Nenhum ponto de retorno marcado.\n\n");
+            } else {
+                // descarta o ramo atual e retoma a sessão salva
+                Sessao *salva = bifurcacoes[--nBifurcacoes];
+                liberarCaderno(s->caderno);
+                *s = *salva;
+                free(salva);
+                contarMetrica(MET_SESSOES_LIBERADAS);
+                if (s->autosave) s->autosave->precisaCompleto = 1;
+                emitir(tx, "Voltando ao ponto marcado...\n\n");
+            }
+        } else if (c == 'r' || c == 'R') {
+            mostrarMemoria(s, table, proc);
+        } else if (c == 'g' || c == 'G') {
+            salvarJogoInterativo(s);
+        } else if (c == 'p' || c == 'P') {
+            mostrarPlacar(tx, s->caderno);
+        } else if (c == 's' || c == 'S') {
+            emitir(tx, "Saindo da exploração...\n");
+            break;
+        } else {
+            emitir(tx, "Opção inválida. Use e, d, c, h, m, v, r, g, p ou s.\n\n");
+        }
+    }
+    if (inicioComando > 0) observarLatencia(agoraNs() - inicioComando);
+    autoSalvar(s->autosave, s, 1);
+    while (nBifurcacoes > 0) liberarSessao(bifurcacoes[--nBifurcacoes]);
+    emitir(tx, "--- Fim da exploração ---\n\n");
+    enviarEspectadores(tx);
+}
+
+/* ----------------------------- Julgamento final ----------------------------- */
+
+/**
+ * verificarSuspeitoFinal()
+ * Conduz a fase de julgamento final: percorre as pistas coletadas e verifica
+ * quantas apontam para o suspeito acusado. Exibe o veredito com base na regra
+ * de pelo menos duas pistas apontando para o mesmo suspeito. Retorna 1 se a
+ * acusação foi válida.
+ */
+
+typedef struct ContagemSuspeito {
+    TabelaPistas *table;
+    const char *suspect;
+    int cnt;
+} ContagemSuspeito;
+
+void contarSeDoSuspeito(const char *pista, void *ctx) {
+    ContagemSuspeito *c = ctx;
+    const char *s = encontrarSuspeito(c->table, pista);
+    if (s && strcmp(s, c->suspect) == 0) c->cnt++;
+}
+
+// Helper: percorre as pistas em ordem e conta quantas correspondem ao suspeito
+int count_clues_for_suspect(const Caderno *caderno, TabelaPistas *table, const char *suspect) {
+    ContagemSuspeito c = { table, suspect, 0 };
+    percorrerPistas(caderno, contarSeDoSuspeito, &c);
+    return c.cnt;
+}
+
+void imprimirPista(const char *pista, void *ctx) {
+    (void)ctx;
+    printf(" - %s\n", pista);
+}
+
+void listarPistas(const Caderno *caderno) {
+    percorrerPistas(caderno, imprimirPista, NULL);
+}
+
+int verificarSuspeitoFinal(const Caderno *collected, TabelaPistas *table) {
+    if (collected->total == 0) {
+        printf("Nenhuma pista foi coletada. Não é possível acusar com fundamento.\n");
+        return 0;
+    }
+    printf("Pistas coletadas:\n");
+    listarPistas(collected);
+
+    char accused[MAX_INPUT];
+    printf("\nDigite o nome do suspeito que você deseja acusar: ");
+    if (!lerLinhaEm(&entrada, accused, sizeof(accused))) return 0;
+    if (strlen(accused) == 0) {
+        printf("Nenhum suspeito informado. Encerrando julgamento.\n");
+        return 0;
+    }
+    // Normalizar a entrada (case-insensitive matching) - assumimos nomes na tabela com mesma capitalização
+    // Contamos pistas que apontam para esse suspeito
+    int count = count_clues_for_suspect(collected, table, accused);
+    printf("\nVocê acusou: %s\n", accused);
+    printf("Pistas que apontam para %s: %d\n", accused, count);
+
+    if (count >= 2) {
+        printf("DESFECHO: Acusação válida! Há provas suficientes para sustentar o caso.\n");
+        contarMetrica(MET_VEREDITOS_VALIDOS);
+        return 1;
+    }
+    contarMetrica(MET_VEREDITOS_FRACOS);
+    printf("DESFECHO: Acusação fraca. Pelo menos 2 pistas são necessárias para condenar.\n");
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "detective.h"
+
+/* ----------------------------- Limpeza de memória ----------------------------- */
+
+void liberarPropriedade(Propriedade *prop) {
+    for (int p = 0; p < prop->def->nPredios; p++) {
+        Predio *predio = &prop->predios[p];
+        for (int a = 0; a < predio->def->nAndares; a++) descarregarAndar(&predio->andares[a]);
+        free(predio->andares);
+    }
+    free(prop->predios);
+    free(prop);
+}
+
+void freeClues(ClueNode *n) {
+    if (!n) return;
+    freeClues(n->left);
+    freeClues(n->right);
+    free(n->clue);
+    free(n);
+}
+
+void freeCaderno(Caderno *c) {
+    freeClues(c->arvore);
+    liberarRadix(c->radix.raiz);
+    liberarListaSaltos(&c->saltos);
+    free(c->linha.eventos);
+    free(c->registros);
+    for (int i = 0; i < c->nSuspeitos; i++) {
+        free(c->suspeitos[i]);
+        free(c->porSuspeito[i].itens);
+    }
+    free(c->suspeitos);
+    free(c->porSuspeito);
+    liberarPlacar(&c->placar);
+    for (int i = 0; i < c->nSalas; i++) free(c->porSala[i].itens);
+    free(c->porSala);
+    inicializarCaderno(c);
+}
+
+void freeHash(TabelaPistas *table) {
+    for (int i=0;i<HASH_SIZE;i++) {
+        HashEntry *cur = table->baldes[i];
+        while (cur) {
+            HashEntry *tmp = cur;
+            cur = cur->next;
+            liberarNo(&poolEntradasHash, tmp);   // textos pertencem ao dicionário
+        }
+        table->baldes[i] = NULL;
+    }
+}
+
+void liberarPacote(PacoteCasos *pc) {
+    for (int i = 0; i < pc->nCasos; i++) {
+        freeHash(&pc->casos[i].tabela);
+        freeProcedencia(&pc->casos[i].procedencia);
+        liberarDescricoes(&pc->casos[i].descricoes);
+        free(pc->casos[i].idas);
+    }
+    for (int i = 0; i < pc->nPropriedades; i++) liberarPropriedade(pc->propriedades[i]);
+    free(pc->propriedades);
+    free(pc->casos);
+    free(pc->tabelaIds);
+    liberarDicionario(&pc->dic);
+    free(pc);
+}
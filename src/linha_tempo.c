@@ -0,0 +1,255 @@
+#include "detective.h"
+
+/* ----------------------------- Linha do tempo ----------------------------- */
+
+void anexarEvento(LinhaDoTempo *l, int pista, int movimento) {
+    if (l->total == l->capacidade) {
+        int cap = l->capacidade ? l->capacidade * 2 : 8;
+        EventoPista *novo = realloc(l->eventos, cap * sizeof(EventoPista));
+        if (!novo) { perror("realloc"); exit(EXIT_FAILURE); }
+        l->eventos = novo;
+        l->capacidade = cap;
+    }
+    l->eventos[l->total].pista = pista;
+    l->eventos[l->total].movimento = movimento;
+    l->total++;
+}
+
+// Primeira posição com movimento >= mov (busca binária)
+int limiteInferiorMovimento(const LinhaDoTempo *l, int mov) {
+    int lo = 0, hi = l->total;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (l->eventos[mid].movimento < mov) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * ultimasPistas()
+ * Aponta *inicio para as últimas n descobertas (sem cópia) e retorna quantas são.
+ */
+int ultimasPistas(const LinhaDoTempo *l, int n, const EventoPista **inicio) {
+    if (n > l->total) n = l->total;
+    if (n < 0) n = 0;
+    *inicio = l->eventos + (l->total - n);
+    return n;
+}
+
+/**
+ * pistasEntreMovimentos()
+ * Aponta *inicio para as descobertas feitas entre os movimentos a e b
+ * (inclusive) e retorna quantas são. O(log n) para localizar a faixa.
+ */
+int pistasEntreMovimentos(const LinhaDoTempo *l, int a, int b, const EventoPista **inicio) {
+    int ini = limiteInferiorMovimento(l, a);
+    int fim = limiteInferiorMovimento(l, b + 1);
+    *inicio = l->eventos + ini;
+    return fim > ini ? fim - ini : 0;
+}
+
+/**
+ * anexarRegistro()
+ * Parte de registrarPista() posterior ao índice de pistas: registro, evento na
+ * linha do tempo e índices secundários. Não é segura para uso concorrente; no
+ * modo cooperativo é chamada pela thread principal depois das coletas.
+ */
+void anexarRegistro(Caderno *c, int pistaId, const char *clue, const Room *sala,
+                    const char *suspeito, int movimento) {
+    anexarEvento(&c->linha, pistaId, movimento);
+
+    if (c->total == c->capacidade) {
+        int cap = c->capacidade ? c->capacidade * 2 : 8;
+        RegistroPista *novo = realloc(c->registros, cap * sizeof(RegistroPista));
+        if (!novo) { perror("realloc"); exit(EXIT_FAILURE); }
+        c->registros = novo;
+        c->capacidade = cap;
+    }
+    int pos = c->total++;
+    RegistroPista *r = &c->registros[pos];
+    r->pista = clue;
+    r->sala = sala->id;
+    r->andar = sala->andar ? sala->andar->id : -1;
+    r->suspeito = idSuspeito(c, suspeito);
+    r->movimento = movimento;
+
+    contarMetrica(MET_PISTAS_INSERIDAS);
+    if (r->suspeito >= 0) {
+        anexarIndice(&c->porSuspeito[r->suspeito], pos);
+        ajustarPlacar(&c->placar, r->suspeito, 1);
+    }
+    anexarIndice(indiceDaSala(c, r->sala), pos);
+}
+
+/**
+ * registrarPista()
+ * Insere a pista no índice de pistas do caderno (BST, ART ou lista de saltos)
+ * e, se for nova, acrescenta seu registro com anexarRegistro().
+ * Retorna 1 se a pista era nova.
+ */
+// Insere só no índice de pistas; retorna 1 se a pista era nova
+int inserirNoIndiceDePistas(Caderno *c, const char *clue) {
+    if (c->indice == INDICE_ART) return inserirNaRadix(&c->radix, clue);
+    if (c->indice == INDICE_SALTOS) {
+        int nova;
+        inserirNaListaSaltos(&c->saltos, clue, &nova);
+        return nova;
+    }
+    if (buscarPista(c->arvore, clue)) return 0;
+    c->arvore = inserirPista(c->arvore, clue);
+    return 1;
+}
+
+int registrarPista(Caderno *c, int pistaId, const char *clue, const Room *sala,
+                   const char *suspeito, int movimento) {
+    if (!clue) return 0;
+    if (!inserirNoIndiceDePistas(c, clue)) return 0;
+    anexarRegistro(c, pistaId, clue, sala, suspeito, movimento);
+    return 1;
+}
+
+int registroAtendeFiltro(const RegistroPista *r, const FiltroPistas *f, int suspeito) {
+    if (f->suspeito && r->suspeito != suspeito) return 0;
+    if (f->sala >= 0 && r->sala != f->sala) return 0;
+    if (f->andar >= 0 && r->andar != f->andar) return 0;
+    if (r->movimento < f->movimentoMin) return 0;
+    if (f->movimentoMax >= 0 && r->movimento > f->movimentoMax) return 0;
+    return 1;
+}
+
+/**
+ * consultarPistas()
+ * Executa uma consulta sobre as pistas coletadas. O planejador estima quantos
+ * candidatos cada índice produz (lista do suspeito, lista da sala ou faixa de
+ * movimentos obtida por busca binária) e percorre apenas o mais seletivo,
+ * verificando os demais predicados (inclusive o andar) em cada candidato.
+ * Grava até `max` posições de registros em `saida` (em ordem de descoberta)
+ * e retorna o total de resultados. Se `plano` não for NULL, informa o índice usado.
+ */
+int consultarPistas(const Caderno *c, const FiltroPistas *f,
+                    int *saida, int max, PlanoConsulta *plano) {
+    int suspeito = -1;
+    if (f->suspeito) {
+        suspeito = procurarSuspeito(c, f->suspeito);
+        if (suspeito < 0) { if (plano) *plano = PLANO_SUSPEITO; return 0; }
+    }
+
+    // faixa de tempo: registros[ini, fim)
+    int ini = limiteInferiorMovimento(&c->linha, f->movimentoMin);
+    int fim = f->movimentoMax >= 0 ? limiteInferiorMovimento(&c->linha, f->movimentoMax + 1) : c->total;
+    if (fim < ini) fim = ini;
+
+    PlanoConsulta escolhido = (ini > 0 || fim < c->total) ? PLANO_TEMPO : PLANO_VARREDURA;
+    int melhor = fim - ini;
+    const ListaIndices *lista = NULL;
+
+    if (suspeito >= 0 && c->porSuspeito[suspeito].total < melhor) {
+        lista = &c->porSuspeito[suspeito];
+        melhor = lista->total;
+        escolhido = PLANO_SUSPEITO;
+    }
+    if (f->sala >= 0) {
+        const ListaIndices *ls = f->sala < c->nSalas ? &c->porSala[f->sala] : NULL;
+        int n = ls ? ls->total : 0;
+        if (n < melhor) {
+            lista = ls;
+            melhor = n;
+            escolhido = PLANO_SALA;
+        }
+    }
+    if (plano) *plano = escolhido;
+
+    int achados = 0;
+    int n = lista ? lista->total : (escolhido == PLANO_SALA ? 0 : fim - ini);
+    for (int i = 0; i < n; i++) {
+        int pos = lista ? lista->itens[i] : ini + i;
+        if (!registroAtendeFiltro(&c->registros[pos], f, suspeito)) continue;
+        if (achados < max) saida[achados] = pos;
+        achados++;
+    }
+    return achados;
+}
+
+// Localiza uma sala pelo nome na árvore de cômodos
+Room *buscarSala(Room *r, const char *nome) {
+    if (!r) return NULL;
+    if (strcmp(r->name, nome) == 0) return r;
+    Room *achada = buscarSala(r->left, nome);
+    return achada ? achada : buscarSala(r->right, nome);
+}
+
+// Localiza um andar pelo nome entre os andares alcançáveis a partir da sala
+Andar *buscarAndar(Room *r, const char *nome) {
+    if (!r) return NULL;
+    if (r->andar && strcmp(r->andar->def->nome, nome) == 0) return r->andar;
+    Andar *achado = buscarAndar(r->left, nome);
+    return achado ? achado : buscarAndar(r->right, nome);
+}
+
+// Lê um inteiro opcional; retorna `padrao` se a linha estiver vazia
+int lerInteiroOpcional(const char *rotulo, int padrao) {
+    VisaoLinha v;
+    printf("%s", rotulo);
+    if (!lerLinha(&entrada, &v) || v.tamanho == 0) return padrao;
+    return atoi(v.texto);
+}
+
+// Lista as salas onde a pista aparece (direção pista -> salas da procedência)
+static void mostrarSalasDaPista(const IndiceProcedencia *proc, Room *mansao, const char *pista) {
+    int n;
+    const int *salas = salasDaPista(proc, idPista(proc, pista), &n);
+    if (n == 0) return;
+    printf("     aparece em:");
+    for (int i = 0; i < n; i++) {
+        const Room *r = buscarSalaPorId(mansao, salas[i]);
+        printf("%s %s", i ? "," : "", r ? r->name : "?");
+    }
+    printf("\n");
+}
+
+/**
+ * consultarCaderno()
+ * Interface interativa para consultarPistas(): pergunta suspeito, andar, sala e
+ * faixa de movimentos (campos vazios não filtram) e lista as pistas encontradas,
+ * cada uma com as salas onde aparece.
+ */
+void consultarCaderno(const Caderno *c, Room *mansao, const IndiceProcedencia *proc) {
+    static const char *nomesPlano[] = { "varredura", "suspeito", "sala", "tempo" };
+    char suspeito[MAX_INPUT], andar[MAX_INPUT], sala[MAX_INPUT];
+    FiltroPistas f = { NULL, -1, 0, -1, -1 };
+
+    printf("Suspeito (vazio = qualquer): ");
+    if (!lerLinhaEm(&entrada, suspeito, sizeof(suspeito))) return;
+    if (strlen(suspeito) > 0) f.suspeito = suspeito;
+
+    printf("Andar (vazio = qualquer): ");
+    if (!lerLinhaEm(&entrada, andar, sizeof(andar))) return;
+    if (strlen(andar) > 0) {
+        Andar *a = buscarAndar(mansao, andar);
+        if (!a) { printf("Andar desconhecido: %s\n\n", andar); return; }
+        f.andar = a->id;
+    }
+
+    printf("Sala (vazio = qualquer): ");
+    if (!lerLinhaEm(&entrada, sala, sizeof(sala))) return;
+    if (strlen(sala) > 0) {
+        Room *r = buscarSala(mansao, sala);
+        if (!r) { printf("Sala desconhecida: %s\n\n", sala); return; }
+        f.sala = r->id;
+    }
+    f.movimentoMin = lerInteiroOpcional("A partir do movimento (vazio = início): ", 0);
+    f.movimentoMax = lerInteiroOpcional("Até o movimento (vazio = sem limite): ", -1);
+
+    int res[64];
+    PlanoConsulta plano;
+    int n = consultarPistas(c, &f, res, 64, &plano);
+    printf("\n%d pista(s) encontrada(s) (índice usado: %s):\n", n, nomesPlano[plano]);
+    for (int i = 0; i < n && i < 64; i++) {
+        const RegistroPista *r = &c->registros[res[i]];
+        printf(" - [mov %d] %s (%s)\n", r->movimento, r->pista,
+               r->suspeito >= 0 ? c->suspeitos[r->suspeito] : "sem suspeito");
+        mostrarSalasDaPista(proc, mansao, r->pista);
+    }
+    printf("\n");
+}
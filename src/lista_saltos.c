@@ -0,0 +1,128 @@
+#include "detective.h"
+
+/* ----------------------------- Lista de saltos concorrente ----------------------------- */
+
+void inicializarListaSaltos(ListaSaltos *l) {
+    for (int i = 0; i < SALTOS_NIVEIS; i++) atomic_init(&l->cabeca[i], NULL);
+    atomic_init(&l->proximaSeq, 0);
+    atomic_init(&l->publicadas, 0);
+}
+
+// Altura do nó derivada do hash da pista (distribuição geométrica, p = 1/2):
+// dispensa estado de gerador aleatório compartilhado entre threads
+static int niveisDaPista(const char *pista) {
+    uint32_t bits = (hashTexto(pista) * 2654435761u) >> 8;
+    int niveis = 1;
+    while (niveis < SALTOS_NIVEIS && (bits & 1)) {
+        niveis++;
+        bits >>= 1;
+    }
+    return niveis;
+}
+
+// Preenche, em cada nível, o elo a alterar (antes) e o primeiro nó com chave
+// >= pista (depois). Retorna o nó da pista, se já estiver no nível 0.
+static NoSaltos *procurarSaltos(ListaSaltos *l, const char *pista,
+                                _Atomic(NoSaltos*) *antes[], NoSaltos *depois[]) {
+    _Atomic(NoSaltos*) *elos = l->cabeca;
+    for (int nivel = SALTOS_NIVEIS - 1; nivel >= 0; nivel--) {
+        NoSaltos *atual = atomic_load_explicit(&elos[nivel], memory_order_acquire);
+        while (atual && strcmp(atual->pista, pista) < 0) {
+            elos = atual->prox;
+            atual = atomic_load_explicit(&elos[nivel], memory_order_acquire);
+        }
+        antes[nivel] = &elos[nivel];
+        depois[nivel] = atual;
+    }
+    return depois[0] && strcmp(depois[0]->pista, pista) == 0 ? depois[0] : NULL;
+}
+
+/**
+ * inserirNaListaSaltos()
+ * Insere a pista sem travas; pode ser chamada por várias threads ao mesmo
+ * tempo. Retorna o nó da pista (novo ou já existente) e grava em *nova se
+ * esta chamada foi a que a inseriu.
+ */
+NoSaltos *inserirNaListaSaltos(ListaSaltos *l, const char *pista, int *nova) {
+    _Atomic(NoSaltos*) *antes[SALTOS_NIVEIS];
+    NoSaltos *depois[SALTOS_NIVEIS];
+    NoSaltos *novo = NULL;
+    for (;;) {
+        NoSaltos *existente = procurarSaltos(l, pista, antes, depois);
+        if (existente) {
+            free(novo);   // nunca ficou visível para outras threads
+            *nova = 0;
+            return existente;
+        }
+        if (!novo) {
+            int niveis = niveisDaPista(pista);
+            size_t tam = strlen(pista) + 1;
+            size_t cabecalho = sizeof(NoSaltos) + niveis * sizeof(_Atomic(NoSaltos*));
+            novo = malloc(cabecalho + tam);
+            if (!novo) { perror("malloc"); exit(EXIT_FAILURE); }
+            memcpy((char*)novo + cabecalho, pista, tam);
+            novo->pista = (char*)novo + cabecalho;
+            novo->niveis = niveis;
+            atomic_init(&novo->seq, SALTOS_SEM_SEQUENCIA);
+        }
+        for (int i = 0; i < novo->niveis; i++)
+            atomic_store_explicit(&novo->prox[i], depois[i], memory_order_relaxed);
+        NoSaltos *esperado = depois[0];
+        if (atomic_compare_exchange_strong_explicit(antes[0], &esperado, novo,
+                                                    memory_order_release, memory_order_relaxed))
+            break;
+        // outra thread alterou o nível 0 neste ponto: refaz a busca
+    }
+
+    // numera e publica em ordem: um instantâneo nunca vê a sequência S sem ver
+    // todas as anteriores
+    unsigned seq = atomic_fetch_add_explicit(&l->proximaSeq, 1, memory_order_relaxed);
+    atomic_store_explicit(&novo->seq, seq, memory_order_relaxed);
+    while (atomic_load_explicit(&l->publicadas, memory_order_acquire) != seq) sched_yield();
+    atomic_store_explicit(&l->publicadas, seq + 1, memory_order_release);
+
+    // níveis superiores são apenas atalhos: ligados depois, sem afetar o conteúdo
+    for (int i = 1; i < novo->niveis; i++) {
+        for (;;) {
+            NoSaltos *esperado = depois[i];
+            atomic_store_explicit(&novo->prox[i], esperado, memory_order_relaxed);
+            if (atomic_compare_exchange_strong_explicit(antes[i], &esperado, novo,
+                                                        memory_order_release, memory_order_relaxed))
+                break;
+            procurarSaltos(l, novo->pista, antes, depois);
+        }
+    }
+    *nova = 1;
+    return novo;
+}
+
+int buscarNaListaSaltos(ListaSaltos *l, const char *pista) {
+    _Atomic(NoSaltos*) *antes[SALTOS_NIVEIS];
+    NoSaltos *depois[SALTOS_NIVEIS];
+    return procurarSaltos(l, pista, antes, depois) != NULL;
+}
+
+/**
+ * percorrerListaSaltos()
+ * Visita em ordem alfabética um instantâneo consistente: as pistas publicadas
+ * até o início da chamada, ignorando as que forem inseridas durante a visita.
+ * Retorna o número de pistas do instantâneo.
+ */
+unsigned percorrerListaSaltos(ListaSaltos *l, void (*visitar)(const char *pista, void *ctx), void *ctx) {
+    unsigned versao = atomic_load_explicit(&l->publicadas, memory_order_acquire);
+    NoSaltos *n = atomic_load_explicit(&l->cabeca[0], memory_order_acquire);
+    for (; n; n = atomic_load_explicit(&n->prox[0], memory_order_acquire))
+        if (atomic_load_explicit(&n->seq, memory_order_relaxed) < versao) visitar(n->pista, ctx);
+    return versao;
+}
+
+// Libera os nós; não pode haver inserções em andamento
+void liberarListaSaltos(ListaSaltos *l) {
+    NoSaltos *n = atomic_load(&l->cabeca[0]);
+    while (n) {
+        NoSaltos *prox = atomic_load(&n->prox[0]);
+        free(n);
+        n = prox;
+    }
+    inicializarListaSaltos(l);
+}
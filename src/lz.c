@@ -0,0 +1,230 @@
+#include "detective.h"
+
+/* ----------------------------- Compressão LZ ----------------------------- */
+
+/*
+ Formato de sequência no estilo LZ4: token (4 bits de literais | 4 bits de
+ casamento), extensões de tamanho em bytes 255, literais, deslocamento de 16
+ bits e extensão do casamento. A última sequência tem apenas literais.
+*/
+#define LZ_CASAMENTO_MIN 4
+#define LZ_BITS_HASH 12
+#define LZ_FIM_LITERAIS 8   // últimos bytes sempre emitidos como literais
+
+// Tamanho máximo da saída de comprimirLz() para n bytes de entrada
+size_t limiteLz(size_t n) {
+    return n + n / 255 + 16;
+}
+
+static uint32_t ler32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint8_t *gravarTamanhoLz(uint8_t *op, size_t resto) {
+    while (resto >= 255) { *op++ = 255; resto -= 255; }
+    *op++ = (uint8_t)resto;
+    return op;
+}
+
+/**
+ * comprimirLz()
+ * Comprime n bytes de `src` em `dst` (que deve ter limiteLz(n) bytes).
+ * Casamentos são encontrados por uma tabela hash de sequências de 4 bytes.
+ * Retorna o tamanho comprimido.
+ */
+size_t comprimirLz(const uint8_t *src, size_t n, uint8_t *dst) {
+    uint32_t tabela[1 << LZ_BITS_HASH];
+    const uint8_t *ip = src, *ancora = src, *fim = src + n;
+    uint8_t *op = dst;
+
+    memset(tabela, 0, sizeof(tabela));
+    if (n > LZ_FIM_LITERAIS + LZ_CASAMENTO_MIN) {
+        const uint8_t *limite = fim - LZ_FIM_LITERAIS - LZ_CASAMENTO_MIN;
+        ip++;
+        while (ip < limite) {
+            uint32_t seq = ler32(ip);
+            uint32_t h = (seq * 2654435761u) >> (32 - LZ_BITS_HASH);
+            const uint8_t *ref = src + tabela[h];
+            tabela[h] = (uint32_t)(ip - src);
+            if (ref >= ip || ip - ref > 65535 || ler32(ref) != seq) { ip++; continue; }
+
+            // estende o casamento até o limite dos literais finais
+            const uint8_t *m = ip + LZ_CASAMENTO_MIN, *r = ref + LZ_CASAMENTO_MIN;
+            while (m < fim - LZ_FIM_LITERAIS && *m == *r) { m++; r++; }
+
+            size_t lit = (size_t)(ip - ancora);
+            size_t casamento = (size_t)(m - ip) - LZ_CASAMENTO_MIN;
+            uint8_t *token = op++;
+            *token = (uint8_t)(((lit >= 15 ? 15 : lit) << 4) | (casamento >= 15 ? 15 : casamento));
+            if (lit >= 15) op = gravarTamanhoLz(op, lit - 15);
+            memcpy(op, ancora, lit);
+            op += lit;
+            size_t desloc = (size_t)(ip - ref);
+            *op++ = (uint8_t)(desloc & 0xFF);
+            *op++ = (uint8_t)(desloc >> 8);
+            if (casamento >= 15) op = gravarTamanhoLz(op, casamento - 15);
+            ip = ancora = m;
+        }
+    }
+
+    size_t lit = (size_t)(fim - ancora);
+    *op++ = (uint8_t)((lit >= 15 ? 15 : lit) << 4);
+    if (lit >= 15) op = gravarTamanhoLz(op, lit - 15);
+    memcpy(op, ancora, lit);
+    op += lit;
+    return (size_t)(op - dst);
+}
+
+/**
+ * descomprimirLz()
+ * Descomprime `n` bytes de `src` em `dst` (capacidade `cap`). Todos os acessos
+ * são verificados; literais curtos e casamentos distantes são copiados em
+ * blocos de 8 ou 16 bytes quando há folga no buffer de saída.
+ * Retorna o tamanho descomprimido ou -1 se os dados forem inválidos.
+ */
+long descomprimirLz(const uint8_t *src, size_t n, uint8_t *dst, size_t cap) {
+    const uint8_t *ip = src, *iend = src + n;
+    uint8_t *op = dst, *oend = dst + cap;
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+        size_t lit = token >> 4;
+        if (lit == 15) {
+            unsigned b;
+            do { if (ip >= iend) return -1; b = *ip++; lit += b; } while (b == 255);
+        }
+        if (lit > (size_t)(iend - ip) || lit > (size_t)(oend - op)) return -1;
+        if (lit <= 16 && iend - ip >= 16 && oend - op >= 16) memcpy(op, ip, 16);   // cópia larga
+        else memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+        if (ip == iend) break;   // última sequência: só literais
+
+        if (iend - ip < 2) return -1;
+        size_t desloc = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (desloc == 0 || desloc > (size_t)(op - dst)) return -1;
+        size_t casamento = token & 15;
+        if (casamento == 15) {
+            unsigned b;
+            do { if (ip >= iend) return -1; b = *ip++; casamento += b; } while (b == 255);
+        }
+        casamento += LZ_CASAMENTO_MIN;
+        if (casamento > (size_t)(oend - op)) return -1;
+
+        const uint8_t *ref = op - desloc;
+        if (desloc >= 16 && casamento + 16 <= (size_t)(oend - op)) {
+            // cópia em blocos; pode escrever até 15 bytes além, sobrescritos depois
+            for (size_t k = 0; k < casamento; k += 16) memcpy(op + k, ref + k, 16);
+        } else if (desloc >= 8 && casamento + 8 <= (size_t)(oend - op)) {
+            for (size_t k = 0; k < casamento; k += 8) memcpy(op + k, ref + k, 8);
+        } else {
+            for (size_t k = 0; k < casamento; k++) op[k] = ref[k];
+        }
+        op += casamento;
+    }
+    return (long)(op - dst);
+}
+
+/*
+ Contêiner de blocos: cada bloco tem um cabeçalho de 8 bytes (tamanho original,
+ tamanho armazenado com o bit 31 indicando bloco sem compressão) seguido dos dados.
+*/
+#define BLOCO_SEM_COMPRESSAO 0x80000000u
+
+// Espaço necessário para montar um bloco de n bytes (cabeçalho + dados)
+size_t limiteBloco(uint32_t n) {
+    size_t lz = limiteLz(n);
+    return 8 + (lz > n ? lz : n);
+}
+
+/**
+ * montarBloco()
+ * Comprime os dados e monta o bloco completo em `saida` (limiteBloco(n)
+ * bytes). Se a compressão não reduzir o tamanho, guarda os dados originais.
+ * Retorna o tamanho do bloco montado.
+ */
+size_t montarBloco(const void *dados, uint32_t n, uint8_t *saida) {
+    uint32_t tamanho = (uint32_t)comprimirLz(dados, n, saida + 8);
+    uint32_t cabecalho[2] = { n, tamanho };
+    if (tamanho >= n) {
+        memcpy(saida + 8, dados, n);
+        tamanho = n;
+        cabecalho[1] = n | BLOCO_SEM_COMPRESSAO;
+    }
+    memcpy(saida, cabecalho, sizeof(cabecalho));
+    return sizeof(cabecalho) + tamanho;
+}
+
+/**
+ * gravarBloco()
+ * Monta e grava um bloco. Retorna 0 em caso de sucesso e -1 em caso de erro.
+ */
+int gravarBloco(FILE *f, const void *dados, uint32_t n) {
+    uint8_t *bloco = malloc(limiteBloco(n));
+    if (!bloco) { perror("malloc"); exit(EXIT_FAILURE); }
+    size_t tamanho = montarBloco(dados, n, bloco);
+    int ok = fwrite(bloco, tamanho, 1, f) == 1;
+    free(bloco);
+    return ok ? 0 : -1;
+}
+
+/**
+ * lerBloco()
+ * Lê e descomprime o próximo bloco. Retorna um buffer alocado (liberar com
+ * free) e grava o tamanho em *n; retorna NULL no fim do arquivo ou se o bloco
+ * estiver corrompido.
+ */
+void *lerBloco(FILE *f, uint32_t *n) {
+    uint32_t cabecalho[2];
+    if (fread(cabecalho, sizeof(cabecalho), 1, f) != 1) return NULL;
+    uint32_t original = cabecalho[0];
+    uint32_t armazenado = cabecalho[1] & ~BLOCO_SEM_COMPRESSAO;
+    int cru = (cabecalho[1] & BLOCO_SEM_COMPRESSAO) != 0;
+    if (cru && armazenado != original) return NULL;
+
+    uint8_t *dados = malloc(armazenado ? armazenado : 1);
+    uint8_t *saida = cru ? dados : malloc(original ? original : 1);
+    if (!dados || !saida) { perror("malloc"); exit(EXIT_FAILURE); }
+    if (armazenado && fread(dados, armazenado, 1, f) != 1) {
+        free(dados);
+        if (!cru) free(saida);
+        return NULL;
+    }
+    if (!cru) {
+        long r = descomprimirLz(dados, armazenado, saida, original);
+        free(dados);
+        if (r != (long)original) { free(saida); return NULL; }
+    }
+    *n = original;
+    return saida;
+}
+
+/**
+ * abrirBlocoNaMemoria()
+ * Equivalente a lerBloco() para um bloco já em memória, em `p` (até `tam`
+ * bytes). Retorna um buffer alocado com um '\0' extra ao final (liberar com
+ * free) e grava o tamanho original em *n; NULL se o bloco estiver corrompido.
+ */
+char *abrirBlocoNaMemoria(const uint8_t *p, size_t tam, uint32_t *n) {
+    uint32_t cabecalho[2];
+    if (tam < sizeof(cabecalho)) return NULL;
+    memcpy(cabecalho, p, sizeof(cabecalho));
+    uint32_t original = cabecalho[0];
+    uint32_t armazenado = cabecalho[1] & ~BLOCO_SEM_COMPRESSAO;
+    if (armazenado > tam - sizeof(cabecalho)) return NULL;
+    char *saida = malloc((size_t)original + 1);
+    if (!saida) { perror("malloc"); exit(EXIT_FAILURE); }
+    if (cabecalho[1] & BLOCO_SEM_COMPRESSAO) {
+        if (armazenado != original) { free(saida); return NULL; }
+        memcpy(saida, p + sizeof(cabecalho), original);
+    } else if (descomprimirLz(p + sizeof(cabecalho), armazenado, (uint8_t*)saida, original) != (long)original) {
+        free(saida);
+        return NULL;
+    }
+    saida[original] = '\0';
+    *n = original;
+    return saida;
+}
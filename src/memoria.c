@@ -0,0 +1,204 @@
+#include "detective.h"
+
+/* ----------------------------- Relatório de memória ----------------------------- */
+
+const char *NOMES_CATEGORIAS_MEMORIA[MEM_CATEGORIAS] = {
+    "salas", "dicionário de textos", "sessões", "cadernos de pistas",
+    "entradas hash", "suspeitos (cadernos)", "índices", "descrições (blob + cache)"
+};
+
+/**
+ * contabilizar()
+ * Soma uma alocação à categoria. Com glibc o tamanho real vem de
+ * malloc_usable_size() mais o cabeçalho do bloco; nos demais sistemas é
+ * estimado arredondando para 16 bytes com um cabeçalho de 8.
+ */
+void contabilizar(RelatorioMemoria *rel, int categoria, const void *p, size_t pedido) {
+    if (!p) return;
+    UsoMemoria *u = &rel->uso[categoria];
+    u->blocos++;
+    u->pedido += pedido;
+#ifdef __GLIBC__
+    u->real += malloc_usable_size((void*)p) + sizeof(size_t);
+#else
+    u->real += ((pedido + sizeof(size_t) + 15) & ~(size_t)15);
+#endif
+}
+
+// Nó de um pool: o custo real é a classe de tamanho, sem cabeçalho do alocador
+// (a menos que o pool esteja entregando nós do malloc)
+void contabilizarNo(RelatorioMemoria *rel, int categoria, const PoolNos *pool, const void *no, size_t pedido) {
+    if (pool->direto) {
+        contabilizar(rel, categoria, no, pedido);
+        return;
+    }
+    UsoMemoria *u = &rel->uso[categoria];
+    u->blocos++;
+    u->pedido += pedido;
+    u->real += pool->tamNo;
+}
+
+// Salas e estruturas da planta (propriedade, prédios, andares carregados)
+void medirPropriedade(RelatorioMemoria *rel, const Propriedade *prop) {
+    contabilizar(rel, MEM_SALAS, prop, sizeof(Propriedade));
+    contabilizar(rel, MEM_SALAS, prop->predios, prop->def->nPredios * sizeof(Predio));
+    for (int p = 0; p < prop->def->nPredios; p++) {
+        const Predio *predio = &prop->predios[p];
+        contabilizar(rel, MEM_SALAS, predio->andares, predio->def->nAndares * sizeof(Andar));
+        for (int a = 0; a < predio->def->nAndares; a++) {
+            const Andar *andar = &predio->andares[a];
+            if (!andar->carregado) continue;
+            contabilizar(rel, MEM_SALAS, andar->salas, andar->def->nSalas * sizeof(Room*));
+            for (int i = 0; i < andar->def->nSalas; i++) {
+                contabilizarNo(rel, MEM_SALAS, &poolSalas, andar->salas[i], sizeof(Room));
+            }
+        }
+    }
+}
+
+void medirPistas(RelatorioMemoria *rel, const ClueNode *n) {
+    if (!n) return;
+    contabilizar(rel, MEM_CADERNOS, n, sizeof(ClueNode));
+    contabilizar(rel, MEM_CADERNOS, n->clue, strlen(n->clue) + 1);
+    medirPistas(rel, n->left);
+    medirPistas(rel, n->right);
+}
+
+void medirRadix(RelatorioMemoria *rel, NoArt *n) {
+    if (!n) return;
+    if (ehFolhaArt(n)) {
+        contabilizar(rel, MEM_CADERNOS, folhaArt(n), sizeof(FolhaArt) + folhaArt(n)->tamanho);
+        return;
+    }
+    contabilizar(rel, MEM_CADERNOS, n, TAMANHO_NO_ART[n->tipo]);
+    int q;
+    NoArt **filhos = filhosArt(n, &q);
+    for (int i = 0; i < q; i++) medirRadix(rel, filhos[i]);
+}
+
+void medirListaSaltos(RelatorioMemoria *rel, const ListaSaltos *l) {
+    for (NoSaltos *n = atomic_load(&l->cabeca[0]); n; n = atomic_load(&n->prox[0]))
+        contabilizar(rel, MEM_CADERNOS, n, sizeof(NoSaltos) + n->niveis * sizeof(n->prox[0]) +
+                                           strlen(n->pista) + 1);
+}
+
+void medirCaderno(RelatorioMemoria *rel, const Caderno *c) {
+    contabilizar(rel, MEM_CADERNOS, c, sizeof(Caderno));
+    medirPistas(rel, c->arvore);
+    medirRadix(rel, c->radix.raiz);
+    medirListaSaltos(rel, &c->saltos);
+    contabilizar(rel, MEM_CADERNOS, c->linha.eventos, c->linha.capacidade * sizeof(EventoPista));
+    contabilizar(rel, MEM_CADERNOS, c->registros, c->capacidade * sizeof(RegistroPista));
+    contabilizar(rel, MEM_SUSPEITOS, c->suspeitos, c->capSuspeitos * sizeof(char*));
+    contabilizar(rel, MEM_INDICES, c->porSuspeito, c->capSuspeitos * sizeof(ListaIndices));
+    contabilizar(rel, MEM_SUSPEITOS, c->placar.heap, c->placar.capacidade * sizeof(int));
+    contabilizar(rel, MEM_SUSPEITOS, c->placar.posicao, c->placar.capacidade * sizeof(int));
+    contabilizar(rel, MEM_SUSPEITOS, c->placar.pontos, c->placar.capacidade * sizeof(int));
+    for (int i = 0; i < c->nSuspeitos; i++) {
+        contabilizar(rel, MEM_SUSPEITOS, c->suspeitos[i], strlen(c->suspeitos[i]) + 1);
+        contabilizar(rel, MEM_INDICES, c->porSuspeito[i].itens, c->porSuspeito[i].capacidade * sizeof(int));
+    }
+    contabilizar(rel, MEM_INDICES, c->porSala, c->nSalas * sizeof(ListaIndices));
+    for (int i = 0; i < c->nSalas; i++)
+        contabilizar(rel, MEM_INDICES, c->porSala[i].itens, c->porSala[i].capacidade * sizeof(int));
+}
+
+void medirSessao(RelatorioMemoria *rel, const Sessao *s) {
+    contabilizar(rel, MEM_SESSOES, s, sizeof(Sessao));
+    medirCaderno(rel, s->caderno);
+}
+
+void medirHash(RelatorioMemoria *rel, const TabelaPistas *table) {
+    for (int i = 0; i < HASH_SIZE; i++) {
+        for (const HashEntry *e = table->baldes[i]; e; e = e->next)
+            contabilizarNo(rel, MEM_ENTRADAS_HASH, &poolEntradasHash, e, sizeof(HashEntry));
+    }
+}
+
+// Textos compartilhados (nomes de salas, pistas, suspeitos, ids de casos)
+void medirDicionario(RelatorioMemoria *rel, const Dicionario *d) {
+    contabilizar(rel, MEM_DICIONARIO, d->textos, d->capacidade * sizeof(char*));
+    for (size_t i = 0; i < d->capacidade; i++)
+        if (d->textos[i]) contabilizar(rel, MEM_DICIONARIO, d->textos[i], strlen(d->textos[i]) + 1);
+}
+
+void medirProcedencia(RelatorioMemoria *rel, const IndiceProcedencia *idx) {
+    int total = idx->inicioSala ? idx->inicioSala[idx->nSalas] : 0;
+    contabilizar(rel, MEM_INDICES, idx->pistas, idx->nPistas * sizeof(char*));
+    contabilizar(rel, MEM_INDICES, idx->inicioSala, (idx->nSalas + 1) * sizeof(int));
+    contabilizar(rel, MEM_INDICES, idx->inicioPista, (idx->nPistas + 1) * sizeof(int));
+    contabilizar(rel, MEM_INDICES, idx->pistasDaSala, total * sizeof(int));
+    contabilizar(rel, MEM_INDICES, idx->salasDaPista, total * sizeof(int));
+    contabilizar(rel, MEM_INDICES, idx->idsPistas.chaves, idx->idsPistas.capacidade * sizeof(char*));
+    contabilizar(rel, MEM_INDICES, idx->idsPistas.valores, idx->idsPistas.capacidade * sizeof(int));
+}
+
+// Número de caracteres (não de bytes) de uma string UTF-8, para alinhar colunas
+int larguraUtf8(const char *s) {
+    int n = 0;
+    for (; *s; s++) if (((unsigned char)*s & 0xC0) != 0x80) n++;
+    return n;
+}
+
+/**
+ * imprimirRelatorioMemoria()
+ * Escreve uma tabela com blocos, bytes solicitados e bytes reais por categoria.
+ */
+void imprimirRelatorioMemoria(FILE *out, const RelatorioMemoria *rel) {
+    UsoMemoria total = {0, 0, 0};
+    fprintf(out, "%-28s %8s %12s %12s\n", "estrutura", "blocos", "bytes", "bytes reais");
+    for (int i = 0; i < MEM_CATEGORIAS; i++) {
+        const UsoMemoria *u = &rel->uso[i];
+        const char *nome = NOMES_CATEGORIAS_MEMORIA[i];
+        fprintf(out, "%s%*s %8zu %12zu %12zu\n", nome, 28 - larguraUtf8(nome), "",
+                u->blocos, u->pedido, u->real);
+        total.blocos += u->blocos;
+        total.pedido += u->pedido;
+        total.real += u->real;
+    }
+    fprintf(out, "%-28s %8zu %12zu %12zu\n", "total", total.blocos, total.pedido, total.real);
+}
+
+void medirDescricoes(RelatorioMemoria *rel, const DescricoesCaso *d) {
+    contabilizar(rel, MEM_DESCRICOES, d->blob, d->capacidadeBlob);
+    contabilizar(rel, MEM_DESCRICOES, d->inicioBloco, d->nBlocos * sizeof(uint32_t));
+    contabilizar(rel, MEM_DESCRICOES, d->posicoes, d->nSalas * sizeof(PosicaoDescricao));
+    contabilizar(rel, MEM_DESCRICOES, d->pendente, d->capacidadePendente);
+    for (int i = 0; i < d->nCache; i++)
+        contabilizar(rel, MEM_DESCRICOES, d->cache[i].texto, d->cache[i].tamanho);
+}
+
+void medirMemoria(RelatorioMemoria *rel, const Sessao *s, TabelaPistas *table, const IndiceProcedencia *proc) {
+    memset(rel, 0, sizeof(*rel));
+    const Propriedade *prop = s->mansao->andar->predio->propriedade;
+    medirPropriedade(rel, prop);
+    medirDicionario(rel, prop->dic);
+    medirSessao(rel, s);
+    medirHash(rel, table);
+    medirProcedencia(rel, proc);
+    if (s->caso) medirDescricoes(rel, &s->caso->descricoes);
+}
+
+void mostrarMemoria(const Sessao *s, TabelaPistas *table, const IndiceProcedencia *proc) {
+    RelatorioMemoria rel;
+    medirMemoria(&rel, s, table, proc);
+    printf("\n");
+    imprimirRelatorioMemoria(stdout, &rel);
+    printf("\n");
+}
+
+// Último relatório da sessão em jogo, lido pelo endpoint de métricas
+atomic_size_t memoriaPublicada[MEM_CATEGORIAS];
+
+/**
+ * publicarMemoria()
+ * mede a sessão e deixa os bytes reais de cada categoria à vista da thread de métricas.
+ * Percorrer as estruturas custa caro, por isso só é chamada ao chegar numa sala.
+ */
+void publicarMemoria(const Sessao *s, TabelaPistas *table, const IndiceProcedencia *proc) {
+    if (!metricasAtivas) return;
+    RelatorioMemoria rel;
+    medirMemoria(&rel, s, table, proc);
+    for (int i = 0; i < MEM_CATEGORIAS; i++)
+        atomic_store_explicit(&memoriaPublicada[i], rel.uso[i].real, memory_order_relaxed);
+}
@@ -0,0 +1,201 @@
+#include "detective.h"
+
+/* ----------------------------- Métricas ----------------------------- */
+
+// Os ganchos não fazem nada até --metricas ligar a coleta
+int metricasAtivas = 0;
+static FatiaMetricas fatiasMetricas[MAX_FATIAS_METRICAS];
+static const double LIMITES_LATENCIA_NS[MET_FAIXAS_LATENCIA] = {
+    1e3, 2.5e3, 5e3, 1e4, 2.5e4, 5e4, 1e5, 2.5e5, 5e5, 1e6, 2.5e6, 5e6
+};
+
+// Fatia da CPU em que a thread está: threads em CPUs diferentes não disputam a linha
+static FatiaMetricas *fatiaDaCpu(void) {
+    int cpu = sched_getcpu();
+    return &fatiasMetricas[(cpu < 0 ? 0 : cpu) % MAX_FATIAS_METRICAS];
+}
+
+void contarMetrica(int contador) {
+    if (!metricasAtivas) return;
+    atomic_fetch_add_explicit(&fatiaDaCpu()->contadores[contador], 1, memory_order_relaxed);
+}
+
+// Registra no histograma a duração de um comando
+void observarLatencia(double ns) {
+    if (!metricasAtivas) return;
+    int faixa = 0;
+    while (faixa < MET_FAIXAS_LATENCIA && ns > LIMITES_LATENCIA_NS[faixa]) faixa++;
+    FatiaMetricas *f = fatiaDaCpu();
+    atomic_fetch_add_explicit(&f->latencia[faixa], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&f->latenciaSomaNs, (unsigned long)ns, memory_order_relaxed);
+}
+
+// Soma das fatias de um contador (só na leitura)
+static unsigned long somarFatias(const atomic_ulong *(*campo)(const FatiaMetricas*, int), int i) {
+    unsigned long total = 0;
+    for (int f = 0; f < MAX_FATIAS_METRICAS; f++)
+        total += atomic_load_explicit(campo(&fatiasMetricas[f], i), memory_order_relaxed);
+    return total;
+}
+
+static const atomic_ulong *campoContador(const FatiaMetricas *f, int i) { return &f->contadores[i]; }
+static const atomic_ulong *campoLatencia(const FatiaMetricas *f, int i) { return &f->latencia[i]; }
+static const atomic_ulong *campoSomaLatencia(const FatiaMetricas *f, int i) { (void)i; return &f->latenciaSomaNs; }
+
+/* ----------------------------- Endpoint de métricas ----------------------------- */
+
+static ServidorMetricas servidorMetricas = { .fd = -1 };
+
+static const char *NOMES_METRICAS[MET_CONTADORES] = {
+    "detective_sessoes_criadas_total", "detective_sessoes_liberadas_total",
+    "detective_movimentos_total", "detective_pistas_inseridas_total",
+    "detective_consultas_hash_total", "detective_vereditos_validos_total",
+    "detective_vereditos_fracos_total", "detective_blocos_antecipados_total"
+};
+static const char *AJUDAS_METRICAS[MET_CONTADORES] = {
+    "Sessões criadas, incluindo bifurcações.", "Sessões liberadas.",
+    "Movimentos entre salas (exploração e modo cooperativo).", "Pistas anexadas a cadernos.",
+    "Consultas pista -> suspeito na tabela hash.", "Acusações sustentadas por 2 ou mais pistas.",
+    "Acusações sem provas suficientes.",
+    "Blocos de descrições descomprimidos pelo pré-carregamento antes da visita."
+};
+
+/**
+ * escreverMetricas()
+ * Soma as fatias por CPU e escreve tudo no formato de texto do Prometheus.
+ */
+void escreverMetricas(FILE *out) {
+    unsigned long valores[MET_CONTADORES];
+    for (int i = 0; i < MET_CONTADORES; i++) {
+        valores[i] = somarFatias(campoContador, i);
+        fprintf(out, "# HELP %s %s\n# TYPE %s counter\n%s %lu\n",
+                NOMES_METRICAS[i], AJUDAS_METRICAS[i], NOMES_METRICAS[i], NOMES_METRICAS[i], valores[i]);
+    }
+    // as duas somas não são lidas juntas: a diferença pode passar por um instante negativa
+    long ativas = (long)valores[MET_SESSOES_CRIADAS] - (long)valores[MET_SESSOES_LIBERADAS];
+    fprintf(out, "# HELP detective_sessoes_ativas Sessões em memória.\n"
+                 "# TYPE detective_sessoes_ativas gauge\ndetective_sessoes_ativas %ld\n", ativas > 0 ? ativas : 0);
+
+    fprintf(out, "# HELP detective_comando_segundos Tempo de resposta a um comando da exploração.\n"
+                 "# TYPE detective_comando_segundos histogram\n");
+    unsigned long acumulado = 0;
+    for (int f = 0; f <= MET_FAIXAS_LATENCIA; f++) {
+        acumulado += somarFatias(campoLatencia, f);
+        if (f < MET_FAIXAS_LATENCIA)
+            fprintf(out, "detective_comando_segundos_bucket{le=\"%g\"} %lu\n", LIMITES_LATENCIA_NS[f] / 1e9, acumulado);
+        else
+            fprintf(out, "detective_comando_segundos_bucket{le=\"+Inf\"} %lu\n", acumulado);
+    }
+    fprintf(out, "detective_comando_segundos_sum %.9f\ndetective_comando_segundos_count %lu\n",
+            somarFatias(campoSomaLatencia, 0) / 1e9, acumulado);
+
+    fprintf(out, "# HELP detective_memoria_bytes Bytes reais por estrutura, medidos na última sala visitada.\n"
+                 "# TYPE detective_memoria_bytes gauge\n");
+    for (int i = 0; i < MEM_CATEGORIAS; i++)
+        fprintf(out, "detective_memoria_bytes{estrutura=\"%s\"} %zu\n", NOMES_CATEGORIAS_MEMORIA[i],
+                atomic_load_explicit(&memoriaPublicada[i], memory_order_relaxed));
+
+    fprintf(out, "# HELP detective_atividade_segundos Tempo desde que as métricas foram ligadas.\n"
+                 "# TYPE detective_atividade_segundos gauge\ndetective_atividade_segundos %.3f\n",
+            (agoraNs() - servidorMetricas.inicio) / 1e9);
+}
+
+// Atende uma conexão: com "GET ..." responde em HTTP/1.0; sem pedido (nc -U, socat) só o texto
+static void atenderMetricas(int cliente) {
+    char pedido[512];
+    ssize_t lido = 0;
+    struct pollfd pfd = { .fd = cliente, .events = POLLIN };
+    if (poll(&pfd, 1, 100) > 0) lido = recv(cliente, pedido, sizeof(pedido), 0);
+
+    char *corpo = NULL;
+    size_t tamCorpo = 0;
+    FILE *out = open_memstream(&corpo, &tamCorpo);
+    if (!out) { perror("open_memstream"); return; }
+    escreverMetricas(out);
+    fclose(out);
+
+    char cabecalho[160];
+    int tamCabecalho = 0;
+    if (lido >= 3 && memcmp(pedido, "GET", 3) == 0)
+        tamCabecalho = snprintf(cabecalho, sizeof(cabecalho),
+                                "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                                "Content-Length: %zu\r\n\r\n", tamCorpo);
+    if (tamCabecalho > 0) send(cliente, cabecalho, tamCabecalho, MSG_NOSIGNAL);
+    for (size_t enviado = 0; enviado < tamCorpo; ) {
+        ssize_t n = send(cliente, corpo + enviado, tamCorpo - enviado, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        enviado += n;
+    }
+    free(corpo);
+}
+
+static void *executarServidorMetricas(void *arg) {
+    ServidorMetricas *sv = arg;
+    for (;;) {
+        int cliente = accept(sv->fd, NULL, NULL);
+        if (cliente < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;   // socket desligado por encerrarMetricas()
+        }
+        atenderMetricas(cliente);
+        close(cliente);
+    }
+    return NULL;
+}
+
+void encerrarMetricas(void) {
+    ServidorMetricas *sv = &servidorMetricas;
+    if (sv->fd < 0) return;
+    shutdown(sv->fd, SHUT_RDWR);   // acorda o accept() bloqueado
+    pthread_join(sv->thread, NULL);
+    close(sv->fd);
+    unlink(sv->caminho);
+    sv->fd = -1;
+    metricasAtivas = 0;
+}
+
+/**
+ * iniciarMetricas()
+ * Liga a coleta e abre o endpoint no socket Unix `caminho`; cada conexão
+ * recebe o estado atual (curl --unix-socket <caminho> http://x/metrics).
+ * O socket é removido ao fim do programa. Retorna 0 em caso de sucesso.
+ */
+int iniciarMetricas(const char *caminho) {
+    ServidorMetricas *sv = &servidorMetricas;
+    struct sockaddr_un end;
+    memset(&end, 0, sizeof(end));
+    end.sun_family = AF_UNIX;
+    if (strlen(caminho) >= sizeof(end.sun_path)) {
+        fprintf(stderr, "Caminho do socket de métricas longo demais: %s\n", caminho);
+        return -1;
+    }
+    strcpy(end.sun_path, caminho);
+
+    // só remove o que for socket (deixado por uma execução anterior): um
+    // diário ou jogo salvo passado por engano fica intacto
+    struct stat st;
+    if (lstat(caminho, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "%s: já existe e não é um socket\n", caminho);
+            return -1;
+        }
+        unlink(caminho);
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) { perror("socket"); return -1; }
+    if (bind(fd, (struct sockaddr *)&end, sizeof(end)) < 0 || listen(fd, 8) < 0) {
+        perror(caminho);
+        close(fd);
+        return -1;
+    }
+    sv->fd = fd;
+    sv->caminho = caminho;
+    sv->inicio = agoraNs();
+    metricasAtivas = 1;
+    if (pthread_create(&sv->thread, NULL, executarServidorMetricas, sv) != 0) {
+        perror("pthread_create");
+        exit(EXIT_FAILURE);
+    }
+    atexit(encerrarMetricas);
+    return 0;
+}
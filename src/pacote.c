@@ -0,0 +1,165 @@
+#include "detective.h"
+
+/* ----------------------------- Pacote de casos ----------------------------- */
+
+// Planta já carregada por outro caso do pacote (estrutura imutável compartilhada)
+Propriedade *propriedadeCompartilhada(PacoteCasos *pc, const DefPropriedade *def) {
+    for (int i = 0; i < pc->nPropriedades; i++)
+        if (pc->propriedades[i]->def == def) return pc->propriedades[i];
+    Propriedade *prop = construirPropriedade(def, &pc->dic);
+    pc->propriedades[pc->nPropriedades++] = prop;
+    return prop;
+}
+
+/**
+ * carregarPacote()
+ * Carrega vários casos em um único processo. Todos os textos passam pelo
+ * dicionário compartilhado, casos com a mesma planta compartilham as salas, e
+ * cada caso mantém seu próprio namespace (tabela pista -> suspeito e índice de
+ * procedência). Os ids dos casos ficam em uma tabela hash para busca O(1).
+ */
+PacoteCasos *carregarPacote(const DefCaso *defs, int n) {
+    PacoteCasos *pc = calloc(1, sizeof(PacoteCasos));
+    if (!pc) { perror("calloc"); exit(EXIT_FAILURE); }
+    inicializarDicionario(&pc->dic);
+    pc->nCasos = n;
+    pc->casos = calloc(n, sizeof(Caso));
+    pc->propriedades = calloc(n, sizeof(Propriedade*));
+    pc->capacidadeIds = 4;
+    while (pc->capacidadeIds < 2 * n) pc->capacidadeIds *= 2;
+    pc->tabelaIds = malloc(pc->capacidadeIds * sizeof(int));
+    if (!pc->casos || !pc->propriedades || !pc->tabelaIds) { perror("malloc"); exit(EXIT_FAILURE); }
+    for (int i = 0; i < pc->capacidadeIds; i++) pc->tabelaIds[i] = -1;
+
+    for (int i = 0; i < n; i++) {
+        Caso *c = &pc->casos[i];
+        c->def = &defs[i];
+        c->id = internar(&pc->dic, defs[i].id);
+        c->propriedade = propriedadeCompartilhada(pc, defs[i].planta);
+        popularTabelaHash(&c->tabela, defs[i].suspeitos, defs[i].nSuspeitos, &pc->dic);
+        construirProcedencia(&c->procedencia, entradaPropriedade(c->propriedade),
+                             defs[i].pistas, defs[i].nPistas, &pc->dic);
+        construirDescricoes(&c->descricoes, entradaPropriedade(c->propriedade),
+                            defs[i].descricoes, defs[i].nDescricoes);
+        c->idas = calloc(c->procedencia.nSalas > 0 ? c->procedencia.nSalas : 1, sizeof(*c->idas));
+        if (!c->idas) { perror("calloc"); exit(EXIT_FAILURE); }
+
+        size_t mascara = pc->capacidadeIds - 1;
+        size_t k = hashTexto(c->id) & mascara;
+        while (pc->tabelaIds[k] >= 0) k = (k + 1) & mascara;
+        pc->tabelaIds[k] = i;
+    }
+    return pc;
+}
+
+/**
+ * buscarCaso()
+ * Localiza um caso pelo id. Retorna NULL se não existir.
+ */
+Caso *buscarCaso(PacoteCasos *pc, const char *id) {
+    const char *canonico = buscarNoDicionario(&pc->dic, id);
+    if (!canonico) return NULL;
+    size_t mascara = pc->capacidadeIds - 1;
+    for (size_t k = hashTexto(canonico) & mascara; pc->tabelaIds[k] >= 0; k = (k + 1) & mascara)
+        if (pc->casos[pc->tabelaIds[k]].id == canonico) return &pc->casos[pc->tabelaIds[k]];
+    return NULL;
+}
+
+// Sala pelo id na árvore de cômodos
+Room *buscarSalaPorId(Room *r, int id) {
+    if (!r) return NULL;
+    if (r->id == id) return r;
+    Room *achada = buscarSalaPorId(r->left, id);
+    return achada ? achada : buscarSalaPorId(r->right, id);
+}
+
+// Recria a sessão a partir do estado completo gravado por serializarJogo()
+Sessao *restaurarJogo(PacoteCasos *pc, const uint8_t *p, size_t tam) {
+    const uint8_t *fim = p + tam;
+    Sessao *s = NULL;
+    char id[MAX_INPUT];
+    int32_t tamId = tam >= 4 ? desserializarInt(&p) : -1;
+    if (tamId < 0 || tamId >= MAX_INPUT || fim - p < tamId + 12) return NULL;
+    memcpy(id, p, (size_t)tamId);
+    id[tamId] = '\0';
+    p += tamId;
+
+    Caso *caso = buscarCaso(pc, id);
+    if (!caso) return NULL;
+    Room *mansao = entradaPropriedade(caso->propriedade);
+    s = criarSessao(mansao);
+    s->caso = caso;
+    s->atual = buscarSalaPorId(mansao, desserializarInt(&p));
+    s->movimento = desserializarInt(&p);
+    int32_t total = desserializarInt(&p);
+    if (!s->atual || total < 0 || (fim - p) / 12 < total) { liberarSessao(s); return NULL; }
+    for (int i = 0; i < total; i++) {
+        int pista = desserializarInt(&p);
+        Room *sala = buscarSalaPorId(mansao, desserializarInt(&p));
+        int movimento = desserializarInt(&p);
+        if (pista < 0 || pista >= caso->procedencia.nPistas || !sala) { liberarSessao(s); return NULL; }
+        const char *texto = caso->procedencia.pistas[pista];
+        registrarPista(s->caderno, pista, texto, sala, encontrarSuspeito(&caso->tabela, texto), movimento);
+    }
+    return s;
+}
+
+// Aplica um delta do salvamento automático. Retorna 0 ou -1 se inválido.
+int aplicarDelta(Sessao *s, const uint8_t *p, size_t tam) {
+    const uint8_t *fim = p + tam;
+    const IndiceProcedencia *proc = &s->caso->procedencia;
+    uint32_t sala, avanco, novas;
+    if (desserializarVarint(&p, fim, &sala) || desserializarVarint(&p, fim, &avanco) ||
+        desserializarVarint(&p, fim, &novas)) return -1;
+    Room *atual = buscarSalaPorId(s->mansao, (int)sala);
+    if (!atual) return -1;
+    int movimento = s->movimento;
+    for (uint32_t i = 0; i < novas; i++) {
+        uint32_t pista, origem, dMov;
+        if (desserializarVarint(&p, fim, &pista) || desserializarVarint(&p, fim, &origem) ||
+            desserializarVarint(&p, fim, &dMov)) return -1;
+        Room *r = buscarSalaPorId(s->mansao, (int)origem);
+        if (pista >= (uint32_t)proc->nPistas || !r) return -1;
+        movimento += (int)dMov;
+        const char *texto = proc->pistas[pista];
+        registrarPista(s->caderno, (int)pista, texto, r, encontrarSuspeito(&s->caso->tabela, texto), movimento);
+    }
+    s->atual = atual;
+    s->movimento += (int)avanco;
+    return 0;
+}
+
+/**
+ * carregarJogo()
+ * Restaura uma sessão de um jogo salvo (gravarJogo) ou de um arquivo de
+ * salvamento automático (checkpoint seguido de deltas). Um delta final
+ * incompleto (gravação interrompida) é ignorado. Retorna NULL em caso de erro.
+ */
+Sessao *carregarJogo(PacoteCasos *pc, const char *caminho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) { perror(caminho); return NULL; }
+    char magico[4];
+    Sessao *s = NULL;
+    uint32_t tam = 0;
+    uint8_t *buf = NULL;
+    if (fread(magico, 4, 1, f) == 1) buf = lerBloco(f, &tam);
+
+    if (buf && memcmp(magico, MAGICO_SAVE, 4) == 0) {
+        s = restaurarJogo(pc, buf, tam);
+    } else if (buf && memcmp(magico, MAGICO_AUTOSAVE, 4) == 0 && tam > 0 && buf[0] == 'F') {
+        s = restaurarJogo(pc, buf + 1, tam - 1);
+        while (s) {
+            free(buf);
+            buf = lerBloco(f, &tam);
+            if (!buf) break;
+            if (tam == 0 || buf[0] != 'D' || aplicarDelta(s, buf + 1, tam - 1) != 0) {
+                liberarSessao(s);
+                s = NULL;
+            }
+        }
+    }
+    free(buf);
+    fclose(f);
+    if (!s) fprintf(stderr, "%s: jogo salvo inválido\n", caminho);
+    return s;
+}
@@ -0,0 +1,145 @@
+#include "detective.h"
+
+/* ----------------------------- Perfilador por amostragem ----------------------------- */
+
+#ifdef TEM_PERFIL
+static Perfilador perfil;
+
+// Tratador de SIGPROF: reserva uma posição com fetch_add e grava a pilha nela
+static void amostrarPilha(int sinal) {
+    (void)sinal;
+    int erroSalvo = errno;
+    int i = atomic_fetch_add_explicit(&perfil.proxima, 1, memory_order_relaxed);
+    if (i < perfil.capacidade) {
+        AmostraPerfil *a = &perfil.amostras[i];
+        a->profundidade = backtrace(a->quadros, PERFIL_PROFUNDIDADE);
+        atomic_store_explicit(&a->pronta, 1, memory_order_release);
+    } else {
+        atomic_fetch_add_explicit(&perfil.descartadas, 1, memory_order_relaxed);
+    }
+    errno = erroSalvo;
+}
+
+// Nome da função de uma linha de backtrace_symbols(): "modulo(funcao+0x1f) [0x...]"
+static void nomeDoQuadro(const char *simbolo, char *nome, size_t tam) {
+    const char *abre = strchr(simbolo, '(');
+    const char *mais = abre ? strpbrk(abre, "+)") : NULL;
+    if (abre && mais && mais > abre + 1) {
+        snprintf(nome, tam, "%.*s", (int)(mais - abre - 1), abre + 1);
+    } else {
+        // sem símbolo (função static, ou compilado sem -rdynamic): módulo e
+        // deslocamento nele, estável entre execuções
+        const char *barra = strrchr(simbolo, '/');
+        const char *inicio = barra ? barra + 1 : simbolo;
+        size_t n = abre ? (size_t)(abre - inicio) : strcspn(inicio, " ");
+        const char *deslocamento = mais && *mais == '+' ? mais : "";
+        snprintf(nome, tam, "%.*s%.*s", (int)n, inicio, (int)strcspn(deslocamento, ")"), deslocamento);
+    }
+    for (char *p = nome; *p; p++)
+        if (*p == ';' || *p == ' ') *p = '_';   // separadores do formato dobrado
+}
+
+static int compararTextos(const void *a, const void *b) {
+    return strcmp(*(char *const*)a, *(char *const*)b);
+}
+
+/**
+ * encerrarPerfil()
+ * Para o temporizador e grava as pilhas em formato dobrado (uma linha
+ * "main;explorarSalas;adicionarPista N" por pilha distinta, da raiz para a
+ * folha), pronto para flamegraph.pl ou speedscope.
+ */
+void encerrarPerfil(void) {
+    struct itimerval parado = { { 0, 0 }, { 0, 0 } };
+    setitimer(ITIMER_PROF, &parado, NULL);
+    signal(SIGPROF, SIG_IGN);
+    int n = atomic_load(&perfil.proxima);
+    if (n > perfil.capacidade) n = perfil.capacidade;
+
+    char **linhas = malloc((n > 0 ? n : 1) * sizeof(char*));
+    if (!linhas) { perror("malloc"); exit(EXIT_FAILURE); }
+    int nLinhas = 0;
+    for (int i = 0; i < n; i++) {
+        AmostraPerfil *a = &perfil.amostras[i];
+        if (!atomic_load_explicit(&a->pronta, memory_order_acquire)) continue;
+        // quadros 0 e 1: o tratador e o trampolim de retorno do sinal
+        int ignorar = a->profundidade > PERFIL_QUADROS_DO_SINAL ? PERFIL_QUADROS_DO_SINAL : 0;
+        char **simbolos = backtrace_symbols(a->quadros + ignorar, a->profundidade - ignorar);
+        if (!simbolos) continue;
+        size_t tam = 0, cap = 256;
+        char *linha = malloc(cap), nome[128];
+        if (!linha) { perror("malloc"); exit(EXIT_FAILURE); }
+        linha[0] = '\0';
+        for (int q = a->profundidade - ignorar - 1; q >= 0; q--) {
+            nomeDoQuadro(simbolos[q], nome, sizeof(nome));
+            size_t len = strlen(nome);
+            if (tam + len + 2 > cap) {
+                cap = (tam + len + 2) * 2;
+                char *maior = realloc(linha, cap);
+                if (!maior) { perror("realloc"); exit(EXIT_FAILURE); }
+                linha = maior;
+            }
+            if (tam > 0) linha[tam++] = ';';
+            memcpy(linha + tam, nome, len + 1);
+            tam += len;
+        }
+        free(simbolos);
+        linhas[nLinhas++] = linha;
+    }
+
+    FILE *f = fopen(perfil.caminho, "w");
+    if (!f) perror(perfil.caminho);
+    qsort(linhas, nLinhas, sizeof(char*), compararTextos);
+    for (int i = 0; i < nLinhas; ) {
+        int j = i;
+        while (j < nLinhas && strcmp(linhas[j], linhas[i]) == 0) j++;
+        if (f) fprintf(f, "%s %d\n", linhas[i], j - i);
+        i = j;
+    }
+    if (f) fclose(f);
+    long descartadas = atomic_load(&perfil.descartadas);
+    fprintf(stderr, "Perfil: %d amostra(s) gravada(s) em %s", nLinhas, perfil.caminho);
+    if (descartadas > 0) fprintf(stderr, " (%ld descartada(s): buffer cheio)", descartadas);
+    fprintf(stderr, "\n");
+    for (int i = 0; i < nLinhas; i++) free(linhas[i]);
+    free(linhas);
+    free(perfil.amostras);
+    perfil.amostras = NULL;
+}
+
+/**
+ * iniciarPerfil()
+ * Liga o perfilador: SIGPROF a cada 1/PERFIL_HZ s de CPU do processo, com as
+ * pilhas gravadas em um buffer pré-alocado. As pilhas são escritas em
+ * `caminho` ao fim do programa (atexit). Retorna 0 em caso de sucesso.
+ */
+int iniciarPerfil(const char *caminho) {
+    perfil.caminho = caminho;
+    perfil.capacidade = PERFIL_MAX_AMOSTRAS;
+    perfil.amostras = calloc(PERFIL_MAX_AMOSTRAS, sizeof(AmostraPerfil));
+    if (!perfil.amostras) { perror("calloc"); exit(EXIT_FAILURE); }
+    // a primeira chamada de backtrace() carrega o desenrolador (e aloca):
+    // fora do tratador de sinal
+    void *aquecimento[1];
+    backtrace(aquecimento, 1);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = amostrarPilha;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    struct itimerval intervalo = { { 0, 1000000 / PERFIL_HZ }, { 0, 1000000 / PERFIL_HZ } };
+    if (sigaction(SIGPROF, &sa, NULL) < 0 || setitimer(ITIMER_PROF, &intervalo, NULL) < 0) {
+        perror("perfil");
+        return -1;
+    }
+    atexit(encerrarPerfil);
+    return 0;
+}
+#else
+int iniciarPerfil(const char *caminho) {
+    (void)caminho;
+    fprintf(stderr, "Perfilador indisponível nesta plataforma (requer glibc).\n");
+    return -1;
+}
+#endif
@@ -0,0 +1,119 @@
+#include "detective.h"
+
+/* ----------------------------- Placar de suspeitos ----------------------------- */
+
+// 1 se o suspeito `a` está à frente de `b` no placar
+static int aFrenteNoPlacar(const PlacarSuspeitos *p, int a, int b) {
+    if (p->pontos[a] != p->pontos[b]) return p->pontos[a] > p->pontos[b];
+    return a < b;
+}
+
+static void trocarNoPlacar(PlacarSuspeitos *p, int i, int j) {
+    int t = p->heap[i];
+    p->heap[i] = p->heap[j];
+    p->heap[j] = t;
+    p->posicao[p->heap[i]] = i;
+    p->posicao[p->heap[j]] = j;
+}
+
+static void subirNoPlacar(PlacarSuspeitos *p, int i) {
+    while (i > 0 && aFrenteNoPlacar(p, p->heap[i], p->heap[(i - 1) / 2])) {
+        trocarNoPlacar(p, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void descerNoPlacar(PlacarSuspeitos *p, int i) {
+    for (;;) {
+        int maior = i, esq = 2 * i + 1, dir = 2 * i + 2;
+        if (esq < p->total && aFrenteNoPlacar(p, p->heap[esq], p->heap[maior])) maior = esq;
+        if (dir < p->total && aFrenteNoPlacar(p, p->heap[dir], p->heap[maior])) maior = dir;
+        if (maior == i) return;
+        trocarNoPlacar(p, i, maior);
+        i = maior;
+    }
+}
+
+/**
+ * ajustarPlacar()
+ * Soma `delta` (positivo ou negativo) aos pontos do suspeito e restaura o heap
+ * em O(log n). Um id igual a p->total entra no placar com zero pontos antes do
+ * ajuste (os ids de suspeitos do caderno são sequenciais).
+ */
+void ajustarPlacar(PlacarSuspeitos *p, int suspeito, int delta) {
+    if (suspeito < 0 || suspeito > p->total) return;
+    if (suspeito == p->total) {
+        if (p->total == p->capacidade) {
+            int cap = p->capacidade ? p->capacidade * 2 : 8;
+            int *heap = realloc(p->heap, cap * sizeof(int));
+            if (heap) p->heap = heap;
+            int *posicao = realloc(p->posicao, cap * sizeof(int));
+            if (posicao) p->posicao = posicao;
+            int *pontos = realloc(p->pontos, cap * sizeof(int));
+            if (pontos) p->pontos = pontos;
+            if (!heap || !posicao || !pontos) { perror("realloc"); exit(EXIT_FAILURE); }
+            p->capacidade = cap;
+        }
+        p->heap[p->total] = suspeito;
+        p->posicao[suspeito] = p->total++;
+        p->pontos[suspeito] = 0;
+        subirNoPlacar(p, p->total - 1);
+    }
+    p->pontos[suspeito] += delta;
+    if (delta > 0) subirNoPlacar(p, p->posicao[suspeito]);
+    else descerNoPlacar(p, p->posicao[suspeito]);
+}
+
+// Cópia independente do placar (para cadernos clonados)
+PlacarSuspeitos clonarPlacar(const PlacarSuspeitos *p) {
+    PlacarSuspeitos copia = *p;
+    if (p->capacidade > 0) {
+        copia.heap = malloc(p->capacidade * sizeof(int));
+        copia.posicao = malloc(p->capacidade * sizeof(int));
+        copia.pontos = malloc(p->capacidade * sizeof(int));
+        if (!copia.heap || !copia.posicao || !copia.pontos) { perror("malloc"); exit(EXIT_FAILURE); }
+        memcpy(copia.heap, p->heap, p->total * sizeof(int));
+        memcpy(copia.posicao, p->posicao, p->total * sizeof(int));
+        memcpy(copia.pontos, p->pontos, p->total * sizeof(int));
+    }
+    return copia;
+}
+
+void liberarPlacar(PlacarSuspeitos *p) {
+    free(p->heap);
+    free(p->posicao);
+    free(p->pontos);
+    memset(p, 0, sizeof(*p));
+}
+
+// Suspeito mais provável (O(1)); -1 se o placar está vazio
+int liderDoPlacar(const PlacarSuspeitos *p) {
+    return p->total > 0 ? p->heap[0] : -1;
+}
+
+/**
+ * primeirosDoPlacar()
+ * Grava em `saida` os até `k` primeiros suspeitos, em ordem, sem alterar o
+ * heap: a fronteira de candidatos parte da raiz e recebe os filhos de cada
+ * escolhido. Retorna quantos foram gravados.
+ */
+int primeirosDoPlacar(const PlacarSuspeitos *p, int *saida, int k) {
+    if (k <= 0 || p->total == 0) return 0;
+    // cada escolha tira um candidato e acrescenta até dois: cabem k + 1
+    int *fronteira = malloc((k + 1) * sizeof(int));
+    if (!fronteira) { perror("malloc"); exit(EXIT_FAILURE); }
+    int nFronteira = 0, n = 0;
+    fronteira[nFronteira++] = 0;
+    while (n < k && nFronteira > 0) {
+        int melhor = 0;
+        for (int i = 1; i < nFronteira; i++)
+            if (aFrenteNoPlacar(p, p->heap[fronteira[i]], p->heap[fronteira[melhor]])) melhor = i;
+        int pos = fronteira[melhor];
+        fronteira[melhor] = fronteira[--nFronteira];
+        saida[n++] = p->heap[pos];
+        if (2 * pos + 1 < p->total) fronteira[nFronteira++] = 2 * pos + 1;
+        if (2 * pos + 2 < p->total) fronteira[nFronteira++] = 2 * pos + 2;
+    }
+    free(fronteira);
+    return n;
+}
@@ -0,0 +1,63 @@
+#include "detective.h"
+
+/* ----------------------------- Pools de nós ----------------------------- */
+
+PoolNos poolSalas = { .tamNo = CLASSE_DE_TAMANHO(sizeof(Room)) };
+PoolNos poolEntradasHash = { .tamNo = CLASSE_DE_TAMANHO(sizeof(HashEntry)) };
+
+// Origem dos nós dos pools que saírem do vazio (--backend nos=pool|malloc)
+int disposicaoNos = NOS_POOL;
+
+/**
+ * alocarNo()
+ * Retorna um nó do pool: o primeiro da lista livre ou o próximo da laje
+ * atual, abrindo uma laje nova quando ela acaba.
+ */
+void *alocarNo(PoolNos *p) {
+    if (p->emUso == 0) p->direto = disposicaoNos == NOS_MALLOC;
+    if (p->direto) {
+        void *no = malloc(p->tamNo);
+        if (!no) { perror("malloc"); exit(EXIT_FAILURE); }
+        p->emUso++;
+        return no;
+    }
+    void *no = p->livres;
+    if (no) {
+        memcpy(&p->livres, no, sizeof(void*));
+    } else {
+        if (p->cursor + p->tamNo > p->fimLaje) {
+            Laje *laje = malloc(TAM_LAJE);
+            if (!laje) { perror("malloc"); exit(EXIT_FAILURE); }
+            laje->proxima = p->lajes;
+            p->lajes = laje;
+            p->nLajes++;
+            p->cursor = (char*)(laje + 1);
+            p->fimLaje = (char*)laje + TAM_LAJE;
+        }
+        no = p->cursor;
+        p->cursor += p->tamNo;
+    }
+    p->emUso++;
+    return no;
+}
+
+// Devolve o nó à lista livre; as lajes voltam ao sistema quando o pool esvazia
+void liberarNo(PoolNos *p, void *no) {
+    if (!no) return;
+    if (p->direto) {
+        free(no);
+        p->emUso--;
+        return;
+    }
+    memcpy(no, &p->livres, sizeof(void*));
+    p->livres = no;
+    if (--p->emUso > 0) return;
+    while (p->lajes) {
+        Laje *prox = p->lajes->proxima;
+        free(p->lajes);
+        p->lajes = prox;
+    }
+    p->cursor = p->fimLaje = NULL;
+    p->livres = NULL;
+    p->nLajes = 0;
+}
@@ -0,0 +1,145 @@
+#include "detective.h"
+
+/* ----------------------------- Procedência das pistas ----------------------------- */
+
+// Quantidade de ids de sala da propriedade que contém `r` (ids de 0 a n - 1)
+int contarIdsSalas(const Room *r) {
+    return r && r->andar ? r->andar->predio->propriedade->nSalas : 0;
+}
+
+int *alocarInts(int n) {
+    int *v = calloc(n > 0 ? n : 1, sizeof(int));
+    if (!v) { perror("calloc"); exit(EXIT_FAILURE); }
+    return v;
+}
+
+// Conta as salas alcançáveis a partir de `r`
+int contarSalas(const Room *r) {
+    return r ? 1 + contarSalas(r->left) + contarSalas(r->right) : 0;
+}
+
+// Nome -> id de cada sala, em pré-ordem (como buscarSala(): vale a primeira)
+void mapearSalas(MapaTextos *m, const Room *r) {
+    if (!r) return;
+    mapearTexto(m, r->name, r->id);
+    mapearSalas(m, r->left);
+    mapearSalas(m, r->right);
+}
+
+/**
+ * construirProcedencia()
+ * Monta, no carregamento do caso, o índice bidirecional sala <-> pista a partir
+ * das associações estáticas. Cada pista distinta recebe um id sequencial e seu
+ * texto é internado no dicionário; salas e pistas são resolvidas por mapas de
+ * textos internados, em tempo linear no número de associações.
+ * Associações com salas inexistentes na mansão são ignoradas.
+ */
+void construirProcedencia(IndiceProcedencia *idx, Room *mansao,
+                          const PistaDeSala *defs, int nDefs, Dicionario *dic) {
+    int *salaDef = alocarInts(nDefs);
+    int *pistaDef = alocarInts(nDefs);
+
+    idx->nSalas = contarIdsSalas(mansao);
+    idx->nPistas = 0;
+    idx->dic = dic;
+    idx->pistas = malloc((nDefs > 0 ? nDefs : 1) * sizeof(char*));
+    if (!idx->pistas) { perror("malloc"); exit(EXIT_FAILURE); }
+    MapaTextos salas;
+    criarMapaTextos(&salas, contarSalas(mansao));
+    mapearSalas(&salas, mansao);
+    criarMapaTextos(&idx->idsPistas, nDefs);
+
+    // resolver nomes para ids
+    for (int i = 0; i < nDefs; i++) {
+        salaDef[i] = buscarNoMapa(&salas, buscarNoDicionario(dic, defs[i].sala));
+        const char *pista = internar(dic, defs[i].pista);
+        int p = mapearTexto(&idx->idsPistas, pista, idx->nPistas);
+        if (p == idx->nPistas) idx->pistas[idx->nPistas++] = pista;
+        pistaDef[i] = p;
+    }
+    liberarMapaTextos(&salas);
+
+    // contagem por sala e por pista, depois soma de prefixos
+    idx->inicioSala = alocarInts(idx->nSalas + 1);
+    idx->inicioPista = alocarInts(idx->nPistas + 1);
+    for (int i = 0; i < nDefs; i++) {
+        if (salaDef[i] < 0) continue;
+        idx->inicioSala[salaDef[i] + 1]++;
+        idx->inicioPista[pistaDef[i] + 1]++;
+    }
+    for (int s = 0; s < idx->nSalas; s++) idx->inicioSala[s + 1] += idx->inicioSala[s];
+    for (int p = 0; p < idx->nPistas; p++) idx->inicioPista[p + 1] += idx->inicioPista[p];
+
+    // preenchimento (mantém a ordem das definições dentro de cada linha)
+    int total = idx->inicioSala[idx->nSalas];
+    int *posSala = alocarInts(idx->nSalas);
+    int *posPista = alocarInts(idx->nPistas);
+    idx->pistasDaSala = alocarInts(total);
+    idx->salasDaPista = alocarInts(total);
+    for (int i = 0; i < nDefs; i++) {
+        int s = salaDef[i], p = pistaDef[i];
+        if (s < 0) continue;
+        idx->pistasDaSala[idx->inicioSala[s] + posSala[s]++] = p;
+        idx->salasDaPista[idx->inicioPista[p] + posPista[p]++] = s;
+    }
+
+    free(posSala);
+    free(posPista);
+    free(salaDef);
+    free(pistaDef);
+}
+
+// Pistas encontradas na sala: retorna o início da linha e grava o tamanho em *n
+const int *pistasDaSala(const IndiceProcedencia *idx, int sala, int *n) {
+    if (sala < 0 || sala >= idx->nSalas) { *n = 0; return NULL; }
+    *n = idx->inicioSala[sala + 1] - idx->inicioSala[sala];
+    return idx->pistasDaSala + idx->inicioSala[sala];
+}
+
+// Salas onde a pista pode ser encontrada
+const int *salasDaPista(const IndiceProcedencia *idx, int pista, int *n) {
+    if (pista < 0 || pista >= idx->nPistas) { *n = 0; return NULL; }
+    *n = idx->inicioPista[pista + 1] - idx->inicioPista[pista];
+    return idx->salasDaPista + idx->inicioPista[pista];
+}
+
+// Id da pista pelo texto (-1 se desconhecida), em O(1) esperado
+int idPista(const IndiceProcedencia *idx, const char *pista) {
+    if (!pista || !idx->dic) return -1;
+    return buscarNoMapa(&idx->idsPistas, buscarNoDicionario(idx->dic, pista));
+}
+
+void freeProcedencia(IndiceProcedencia *idx) {
+    liberarMapaTextos(&idx->idsPistas);
+    free(idx->pistas);
+    free(idx->inicioSala);
+    free(idx->pistasDaSala);
+    free(idx->inicioPista);
+    free(idx->salasDaPista);
+    memset(idx, 0, sizeof(*idx));
+}
+
+/**
+ * mostrarHistorico()
+ * Exibe descobertas em ordem cronológica, usando apenas a linha do tempo: as
+ * últimas n ou, com "a-b", as feitas entre os movimentos a e b.
+ */
+void mostrarHistorico(const LinhaDoTempo *l, const IndiceProcedencia *proc) {
+    VisaoLinha v;
+    const EventoPista *ev;
+    int n, a, b;
+    printf("Quantas pistas recentes, ou faixa de movimentos a-b (vazio = 5): ");
+    if (!lerLinha(&entrada, &v) || v.tamanho == 0) {
+        n = ultimasPistas(l, 5, &ev);
+        printf("\nÚltimas %d pista(s) descobertas:\n", n);
+    } else if (sscanf(v.texto, "%d-%d", &a, &b) == 2) {
+        n = pistasEntreMovimentos(l, a, b, &ev);
+        printf("\n%d pista(s) descobertas entre os movimentos %d e %d:\n", n, a, b);
+    } else {
+        n = ultimasPistas(l, atoi(v.texto), &ev);
+        printf("\nÚltimas %d pista(s) descobertas:\n", n);
+    }
+    for (int i = 0; i < n; i++)
+        printf(" - [mov %d] %s\n", ev[i].movimento, proc->pistas[ev[i].pista]);
+    printf("\n");
+}
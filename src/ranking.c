@@ -0,0 +1,322 @@
+#include "detective.h"
+
+/* ----------------------------- Ranking global de jogadores ----------------------------- */
+
+static NoRanking *noDoElo(uintptr_t elo) {
+    return (NoRanking*)(elo & ~RANKING_MARCA);
+}
+
+static int eloMarcado(uintptr_t elo) {
+    return (elo & RANKING_MARCA) != 0;
+}
+
+// 1 se o nó vem antes de (chave, jogador) na ordem do ranking
+static int noAntesDe(const NoRanking *n, uint64_t chave, uint32_t jogador) {
+    return n->chave < chave || (n->chave == chave && n->jogador < jogador);
+}
+
+/**
+ * chaveRanking()
+ * Chave de ordenação: tempo de solução em ms (menor primeiro) e, no empate,
+ * eficiência em pistas por movimento x 1000 (maior primeiro).
+ */
+uint64_t chaveRanking(uint32_t tempoMs, uint32_t eficiencia) {
+    if (tempoMs == UINT32_MAX) tempoMs--;   // RANKING_AUSENTE fica reservado
+    return (uint64_t)tempoMs << 32 | (UINT32_MAX - eficiencia);
+}
+
+static ItemRanking itemDoNo(const NoRanking *n) {
+    ItemRanking item = { n->jogador, (uint32_t)(n->chave >> 32), UINT32_MAX - (uint32_t)n->chave };
+    return item;
+}
+
+RankingGlobal *criarRanking(int maxJogadores) {
+    RankingGlobal *r = calloc(1, sizeof(RankingGlobal));
+    size_t tamCabeca = sizeof(NoRanking) + RANKING_NIVEIS * sizeof(_Atomic(uintptr_t));
+    if (r) r->cabeca = calloc(1, tamCabeca);
+    if (r) r->chaves = malloc(maxJogadores * sizeof(_Atomic(uint64_t)));
+    if (r) r->nomes = calloc(maxJogadores, sizeof(char*));
+    if (!r || !r->cabeca || !r->chaves || !r->nomes) { perror("malloc"); exit(EXIT_FAILURE); }
+    r->cabeca->niveis = RANKING_NIVEIS;
+    for (int i = 0; i < RANKING_NIVEIS; i++) atomic_init(&r->cabeca->prox[i], 0);
+    for (int i = 0; i < maxJogadores; i++) atomic_init(&r->chaves[i], RANKING_AUSENTE);
+    r->maxJogadores = maxJogadores;
+    atomic_init(&r->aposentados, NULL);
+    return r;
+}
+
+/**
+ * jogadorDoRanking()
+ * Retorna o id do jogador com esse nome, cadastrando-o se necessário; -1 se o
+ * ranking estiver cheio. O cadastro não é seguro para uso concorrente: deve
+ * acontecer antes das threads que atualizam o ranking.
+ */
+int jogadorDoRanking(RankingGlobal *r, const char *nome) {
+    for (int i = 0; i < r->nJogadores; i++)
+        if (strcmp(r->nomes[i], nome) == 0) return i;
+    if (r->nJogadores == r->maxJogadores) return -1;
+    r->nomes[r->nJogadores] = strdup_safe(nome);
+    return r->nJogadores++;
+}
+
+// Altura do nó (p = 1/2) derivada da própria chave, sem gerador compartilhado
+static int niveisDoRanking(uint64_t chave, uint32_t jogador) {
+    uint64_t x = chave ^ ((uint64_t)jogador * 0x9E3779B97F4A7C15ull);
+    x ^= x >> 31;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 29;
+    int niveis = 1;
+    while (niveis < RANKING_NIVEIS && (x & 1)) {
+        niveis++;
+        x >>= 1;
+    }
+    return niveis;
+}
+
+static void aposentarNoRanking(RankingGlobal *r, NoRanking *n) {
+    NoRanking *topo = atomic_load_explicit(&r->aposentados, memory_order_relaxed);
+    do {
+        n->aposentado = topo;
+    } while (!atomic_compare_exchange_weak_explicit(&r->aposentados, &topo, n,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+// Uma passada de procurarRanking(); retorna -1 se um desligamento falhou
+static int tentarProcurarRanking(RankingGlobal *r, uint64_t chave, uint32_t jogador,
+                                 NoRanking *antes[], NoRanking *depois[]) {
+    NoRanking *anterior = r->cabeca;
+    for (int nivel = RANKING_NIVEIS - 1; nivel >= 0; nivel--) {
+        NoRanking *atual = noDoElo(atomic_load_explicit(&anterior->prox[nivel], memory_order_acquire));
+        while (atual) {
+            uintptr_t seguinte = atomic_load_explicit(&atual->prox[nivel], memory_order_acquire);
+            if (eloMarcado(seguinte)) {
+                // nó removido: desliga-o deste nível antes de seguir
+                uintptr_t esperado = (uintptr_t)atual;
+                if (!atomic_compare_exchange_strong_explicit(&anterior->prox[nivel], &esperado,
+                                                             (uintptr_t)noDoElo(seguinte),
+                                                             memory_order_acq_rel, memory_order_acquire))
+                    return -1;
+                if (nivel == 0) aposentarNoRanking(r, atual);
+                atual = noDoElo(seguinte);
+                continue;
+            }
+            if (!noAntesDe(atual, chave, jogador)) break;
+            anterior = atual;
+            atual = noDoElo(seguinte);
+        }
+        antes[nivel] = anterior;
+        depois[nivel] = atual;
+    }
+    return depois[0] && depois[0]->chave == chave && depois[0]->jogador == jogador;
+}
+
+/**
+ * procurarRanking()
+ * Preenche, em cada nível, o último nó antes de (chave, jogador) e o primeiro
+ * a partir dele, desligando no caminho os nós marcados como removidos.
+ * Retorna 1 se a entrada está no nível 0.
+ */
+static int procurarRanking(RankingGlobal *r, uint64_t chave, uint32_t jogador,
+                           NoRanking *antes[], NoRanking *depois[]) {
+    int achou;
+    while ((achou = tentarProcurarRanking(r, chave, jogador, antes, depois)) < 0) {}
+    return achou;
+}
+
+static int inserirNoRanking(RankingGlobal *r, uint64_t chave, uint32_t jogador) {
+    NoRanking *antes[RANKING_NIVEIS], *depois[RANKING_NIVEIS];
+    NoRanking *novo = NULL;
+    for (;;) {
+        if (procurarRanking(r, chave, jogador, antes, depois)) {
+            free(novo);   // nunca ficou visível para outras threads
+            return 0;
+        }
+        if (!novo) {
+            int niveis = niveisDoRanking(chave, jogador);
+            novo = malloc(sizeof(NoRanking) + niveis * sizeof(_Atomic(uintptr_t)));
+            if (!novo) { perror("malloc"); exit(EXIT_FAILURE); }
+            novo->chave = chave;
+            novo->jogador = jogador;
+            novo->niveis = niveis;
+            novo->aposentado = NULL;
+        }
+        for (int i = 0; i < novo->niveis; i++)
+            atomic_init(&novo->prox[i], (uintptr_t)depois[i]);
+        uintptr_t esperado = (uintptr_t)depois[0];
+        if (atomic_compare_exchange_strong_explicit(&antes[0]->prox[0], &esperado, (uintptr_t)novo,
+                                                    memory_order_release, memory_order_relaxed))
+            break;
+    }
+
+    // níveis superiores: atalhos ligados depois; param se o nó for removido
+    for (int i = 1; i < novo->niveis; i++) {
+        for (;;) {
+            uintptr_t proprio = atomic_load_explicit(&novo->prox[i], memory_order_acquire);
+            if (eloMarcado(proprio)) return 1;
+            if (noDoElo(proprio) != depois[i] &&
+                !atomic_compare_exchange_strong_explicit(&novo->prox[i], &proprio, (uintptr_t)depois[i],
+                                                         memory_order_acq_rel, memory_order_acquire))
+                continue;
+            uintptr_t esperado = (uintptr_t)depois[i];
+            if (atomic_compare_exchange_strong_explicit(&antes[i]->prox[i], &esperado, (uintptr_t)novo,
+                                                        memory_order_release, memory_order_relaxed))
+                break;
+            if (!procurarRanking(r, chave, jogador, antes, depois) || depois[0] != novo) return 1;
+        }
+    }
+    return 1;
+}
+
+static int removerDoRanking(RankingGlobal *r, uint64_t chave, uint32_t jogador) {
+    NoRanking *antes[RANKING_NIVEIS], *depois[RANKING_NIVEIS];
+    if (!procurarRanking(r, chave, jogador, antes, depois)) return 0;
+    NoRanking *alvo = depois[0];
+    for (int nivel = alvo->niveis - 1; nivel >= 1; nivel--) {
+        uintptr_t elo = atomic_load_explicit(&alvo->prox[nivel], memory_order_acquire);
+        while (!eloMarcado(elo) &&
+               !atomic_compare_exchange_weak_explicit(&alvo->prox[nivel], &elo, elo | RANKING_MARCA,
+                                                      memory_order_acq_rel, memory_order_acquire)) {}
+    }
+    // a marca do nível 0 decide qual thread removeu o nó
+    uintptr_t elo = atomic_load_explicit(&alvo->prox[0], memory_order_acquire);
+    while (!eloMarcado(elo)) {
+        if (atomic_compare_exchange_weak_explicit(&alvo->prox[0], &elo, elo | RANKING_MARCA,
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            procurarRanking(r, chave, jogador, antes, depois);   // desliga o nó
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * atualizarRanking()
+ * Registra a pontuação atual do jogador: insere a nova entrada e depois remove
+ * a antiga, sem travas. Várias threads podem atualizar jogadores diferentes ao
+ * mesmo tempo; cada jogador deve ser atualizado por uma thread de cada vez.
+ */
+void atualizarRanking(RankingGlobal *r, int jogador, uint32_t tempoMs, uint32_t eficiencia) {
+    if (jogador < 0 || jogador >= r->maxJogadores) return;
+    uint64_t chave = chaveRanking(tempoMs, eficiencia);
+    uint64_t anterior = atomic_load_explicit(&r->chaves[jogador], memory_order_relaxed);
+    if (anterior == chave) return;
+    inserirNoRanking(r, chave, (uint32_t)jogador);
+    atomic_store_explicit(&r->chaves[jogador], chave, memory_order_release);
+    if (anterior != RANKING_AUSENTE) removerDoRanking(r, anterior, (uint32_t)jogador);
+}
+
+// 1 se o nó é a entrada vigente do seu jogador (ignora removidos e substituídos)
+static int noVigente(RankingGlobal *r, const NoRanking *n, uintptr_t seguinte) {
+    return !eloMarcado(seguinte) &&
+           atomic_load_explicit(&r->chaves[n->jogador], memory_order_acquire) == n->chave;
+}
+
+/**
+ * primeirosDoRanking()
+ * Grava em `saida` até `n` entradas vigentes, da melhor para a pior, pelo
+ * nível 0 da lista. Pode rodar junto com atualizações. Retorna quantas gravou.
+ */
+int primeirosDoRanking(RankingGlobal *r, ItemRanking *saida, int n) {
+    int k = 0;
+    NoRanking *no = noDoElo(atomic_load_explicit(&r->cabeca->prox[0], memory_order_acquire));
+    while (no && k < n) {
+        uintptr_t seguinte = atomic_load_explicit(&no->prox[0], memory_order_acquire);
+        if (noVigente(r, no, seguinte)) saida[k++] = itemDoNo(no);
+        no = noDoElo(seguinte);
+    }
+    return k;
+}
+
+/**
+ * posicaoNoRanking()
+ * Posição do jogador (1 = melhor), contando as entradas vigentes à frente dele
+ * no nível 0: custo proporcional à posição. Retorna 0 se o jogador não tem
+ * pontuação.
+ */
+int posicaoNoRanking(RankingGlobal *r, int jogador) {
+    if (jogador < 0 || jogador >= r->maxJogadores) return 0;
+    uint64_t chave = atomic_load_explicit(&r->chaves[jogador], memory_order_acquire);
+    if (chave == RANKING_AUSENTE) return 0;
+    int posicao = 1;
+    NoRanking *no = noDoElo(atomic_load_explicit(&r->cabeca->prox[0], memory_order_acquire));
+    while (no && noAntesDe(no, chave, (uint32_t)jogador)) {
+        uintptr_t seguinte = atomic_load_explicit(&no->prox[0], memory_order_acquire);
+        posicao += noVigente(r, no, seguinte);
+        no = noDoElo(seguinte);
+    }
+    return posicao;
+}
+
+// Jogadores com pontuação no ranking
+int totalDoRanking(RankingGlobal *r) {
+    int total = 0;
+    for (int i = 0; i < r->nJogadores; i++)
+        total += atomic_load_explicit(&r->chaves[i], memory_order_relaxed) != RANKING_AUSENTE;
+    return total;
+}
+
+// Libera o ranking; não pode haver operações em andamento
+void liberarRanking(RankingGlobal *r) {
+    if (!r) return;
+    NoRanking *n = noDoElo(atomic_load(&r->cabeca->prox[0]));
+    while (n) {
+        NoRanking *prox = noDoElo(atomic_load(&n->prox[0]));
+        free(n);
+        n = prox;
+    }
+    for (n = atomic_load(&r->aposentados); n; ) {
+        NoRanking *prox = n->aposentado;
+        free(n);
+        n = prox;
+    }
+    for (int i = 0; i < r->nJogadores; i++) free(r->nomes[i]);
+    free(r->nomes);
+    free(r->chaves);
+    free(r->cabeca);
+    free(r);
+}
+
+#define RANKING_EXIBIDOS 5
+
+/**
+ * registrarResultadoNoRanking()
+ * Carrega o histórico de partidas resolvidas de `caminho` (linhas "nome
+ * tempoMs eficiência"; vale o melhor resultado de cada nome), acrescenta a
+ * partida atual ao arquivo e mostra a posição do jogador e os primeiros.
+ */
+void registrarResultadoNoRanking(const char *caminho, const char *nome, uint32_t tempoMs,
+                                 uint32_t eficiencia) {
+    RankingGlobal *r = criarRanking(RANKING_MAX_JOGADORES);
+    FILE *f = fopen(caminho, "r");
+    if (f) {
+        char linha[MAX_INPUT], outro[MAX_INPUT];
+        unsigned tempo, efic;
+        while (fgets(linha, sizeof(linha), f)) {
+            if (sscanf(linha, "%255s %u %u", outro, &tempo, &efic) != 3) continue;
+            int id = jogadorDoRanking(r, outro);
+            if (id < 0) continue;
+            uint64_t atual = atomic_load(&r->chaves[id]);
+            if (chaveRanking(tempo, efic) < atual) atualizarRanking(r, id, tempo, efic);
+        }
+        fclose(f);
+    }
+    int eu = jogadorDoRanking(r, nome);
+    if (eu >= 0 && chaveRanking(tempoMs, eficiencia) < atomic_load(&r->chaves[eu]))
+        atualizarRanking(r, eu, tempoMs, eficiencia);
+
+    f = fopen(caminho, "a");
+    if (!f || fprintf(f, "%s %u %u\n", nome, tempoMs, eficiencia) < 0) perror(caminho);
+    if (f) fclose(f);
+
+    printf("\nTempo de solução: %.1f s, %.2f pistas por movimento.\n",
+           tempoMs / 1000.0, eficiencia / 1000.0);
+    int posicao = posicaoNoRanking(r, eu);
+    if (posicao > 0)
+        printf("Ranking: %s está em %dº de %d detetives.\n", nome, posicao, totalDoRanking(r));
+    ItemRanking primeiros[RANKING_EXIBIDOS];
+    int n = primeirosDoRanking(r, primeiros, RANKING_EXIBIDOS);
+    for (int i = 0; i < n; i++)
+        printf("%d. %-20s %8.1f s %6.2f pistas/mov\n", i + 1, r->nomes[primeiros[i].jogador],
+               primeiros[i].tempoMs / 1000.0, primeiros[i].eficiencia / 1000.0);
+    liberarRanking(r);
+}
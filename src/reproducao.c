@@ -0,0 +1,179 @@
+#include "detective.h"
+
+/* ----------------------------- Reprodução de diários ----------------------------- */
+
+// Coleta as pistas da sala atual sem mensagens (mesma regra de adicionarPista())
+static void examinarSalaReproduzida(Sessao *s) {
+    const IndiceProcedencia *proc = &s->caso->procedencia;
+    int nPistas;
+    const int *pistas = pistasDaSala(proc, s->atual->id, &nPistas);
+    for (int i = 0; i < nPistas; i++) {
+        const char *clue = proc->pistas[pistas[i]];
+        if (!cadernoContemPista(s->caderno, clue))
+            registrarPista(cadernoParaEscrita(s), pistas[i], clue, s->atual,
+                           encontrarSuspeito(&s->caso->tabela, clue), s->movimento);
+    }
+}
+
+/**
+ * reproduzirComandos()
+ * Aplica as linhas de um bloco do diário à partida em reprodução, na mesma
+ * semântica de explorarSalas(): e/d movem e examinam a nova sala, m/v marcam
+ * e retomam pontos de retorno, os demais comandos só exibem informações.
+ * Retorna 1 quando a linha "#fim" foi conferida.
+ */
+static int reproduzirComandos(PacoteCasos *pc, char *texto, uint32_t tam, Sessao **sessao,
+                              Sessao *bifurcacoes[], int *nBifurcacoes, ResultadoReproducao *res) {
+    char *fim = texto + tam;
+    for (char *linha = texto; linha < fim; ) {
+        char *quebra = memchr(linha, '\n', (size_t)(fim - linha));
+        if (!quebra) quebra = fim;
+        *quebra = '\0';
+        Sessao *s = *sessao;
+        if (strncmp(linha, DIARIO_RETOMADO, strlen(DIARIO_RETOMADO)) == 0) {
+            res->estado = REPRODUCAO_IGNORADA;
+            snprintf(res->detalhe, sizeof(res->detalhe), "partida retomada de um jogo salvo");
+            return 1;
+        } else if (strncmp(linha, DIARIO_CASO, strlen(DIARIO_CASO)) == 0) {
+            Caso *caso = buscarCaso(pc, linha + strlen(DIARIO_CASO));
+            if (!caso || s) {
+                snprintf(res->detalhe, sizeof(res->detalhe), "cabeçalho inválido: %.100s", linha);
+                return 1;
+            }
+            s = *sessao = criarSessao(entradaPropriedade(caso->propriedade));
+            s->caso = caso;
+            examinarSalaReproduzida(s);
+        } else if (strncmp(linha, DIARIO_FIM, strlen(DIARIO_FIM)) == 0) {
+            int movimento, pistas;
+            unsigned resumo;
+            if (!s || sscanf(linha + strlen(DIARIO_FIM), "%d %d %x", &movimento, &pistas, &resumo) != 3) {
+                snprintf(res->detalhe, sizeof(res->detalhe), "linha final inválida: %.100s", linha);
+                return 1;
+            }
+            unsigned obtido = resumoDoCaderno(s->caderno);
+            if (movimento != s->movimento || pistas != s->caderno->total || resumo != obtido) {
+                res->estado = REPRODUCAO_DIVERGENTE;
+                snprintf(res->detalhe, sizeof(res->detalhe),
+                         "esperado %d movimento(s), %d pista(s), resumo %08x; obtido %d, %d, %08x",
+                         movimento, pistas, resumo, s->movimento, s->caderno->total, obtido);
+            } else {
+                res->estado = REPRODUCAO_OK;
+            }
+            return 1;
+        } else if (!s) {
+            snprintf(res->detalhe, sizeof(res->detalhe), "comando antes do cabeçalho do caso");
+            return 1;
+        } else if (*linha) {
+            res->eventos++;
+            char c = (char)tolower((unsigned char)linha[0]);
+            Room *prox = c == 'e' ? s->atual->left : c == 'd' ? s->atual->right : NULL;
+            if (prox) {
+                s->atual = prox;
+                s->movimento++;
+                examinarSalaReproduzida(s);
+            } else if (c == 'm' && *nBifurcacoes < MAX_BIFURCACOES) {
+                bifurcacoes[(*nBifurcacoes)++] = bifurcarSessao(s);
+            } else if (c == 'v' && *nBifurcacoes > 0) {
+                Sessao *salva = bifurcacoes[--*nBifurcacoes];
+                liberarCaderno(s->caderno);
+                *s = *salva;
+                free(salva);
+            }
+        }
+        linha = quebra + 1;
+    }
+    return 0;
+}
+
+/**
+ * reproduzirDiario()
+ * Refaz a partida gravada em um diário a partir dos dados do caso (somente
+ * leitura, compartilhados entre threads) e confere o estado final com a linha
+ * "#fim" gravada pelo jogo.
+ */
+void reproduzirDiario(PacoteCasos *pc, const char *caminho, ResultadoReproducao *res) {
+    memset(res, 0, sizeof(*res));
+    res->estado = REPRODUCAO_ERRO;
+    FILE *f = fopen(caminho, "rb");
+    char magico[4];
+    if (!f || fread(magico, 4, 1, f) != 1 || memcmp(magico, MAGICO_DIARIO, 4) != 0) {
+        snprintf(res->detalhe, sizeof(res->detalhe), "%s", f ? "não é um diário" : strerror(errno));
+        if (f) fclose(f);
+        return;
+    }
+    Sessao *sessao = NULL, *bifurcacoes[MAX_BIFURCACOES];
+    int nBifurcacoes = 0, concluido = 0;
+    uint32_t tam;
+    char *bloco;
+    while (!concluido && (bloco = lerBloco(f, &tam))) {
+        concluido = reproduzirComandos(pc, bloco, tam, &sessao, bifurcacoes, &nBifurcacoes, res);
+        free(bloco);
+    }
+    if (!concluido)
+        snprintf(res->detalhe, sizeof(res->detalhe), "diário truncado ou sem a linha final");
+    while (nBifurcacoes > 0) liberarSessao(bifurcacoes[--nBifurcacoes]);
+    liberarSessao(sessao);
+    fclose(f);
+}
+
+#define MAX_THREADS_REPRODUCAO 64
+
+// Diários a reproduzir; cada thread pega o próximo índice livre
+typedef struct FilaReproducao {
+    PacoteCasos *pacote;
+    const char **caminhos;
+    ResultadoReproducao *resultados;
+    int n;
+    atomic_int proximo;
+} FilaReproducao;
+
+void *trabalharReproducao(void *arg) {
+    FilaReproducao *f = arg;
+    int i;
+    while ((i = atomic_fetch_add(&f->proximo, 1)) < f->n)
+        reproduzirDiario(f->pacote, f->caminhos[i], &f->resultados[i]);
+    return NULL;
+}
+
+/**
+ * executarReproducoes()
+ * Reproduz os diários em paralelo, com uma thread por processador (até
+ * MAX_THREADS_REPRODUCAO), e mostra as divergências, os erros e a vazão em
+ * eventos por segundo. Retorna quantos diários divergiram ou falharam.
+ */
+int executarReproducoes(PacoteCasos *pc, const char **caminhos, int n) {
+    FilaReproducao fila = { pc, caminhos, calloc(n > 0 ? n : 1, sizeof(ResultadoReproducao)), n, 0 };
+    if (!fila.resultados) { perror("calloc"); exit(EXIT_FAILURE); }
+    long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+    int nThreads = processadores > 0 ? (int)processadores : 1;
+    if (nThreads > MAX_THREADS_REPRODUCAO) nThreads = MAX_THREADS_REPRODUCAO;
+    if (nThreads > n) nThreads = n > 0 ? n : 1;
+
+    pthread_t threads[MAX_THREADS_REPRODUCAO];
+    int iniciadas = 0;
+    double t0 = agoraNs();
+    while (iniciadas < nThreads &&
+           pthread_create(&threads[iniciadas], NULL, trabalharReproducao, &fila) == 0)
+        iniciadas++;
+    if (iniciadas == 0) trabalharReproducao(&fila);
+    for (int i = 0; i < iniciadas; i++) pthread_join(threads[i], NULL);
+    double segundos = (agoraNs() - t0) / 1e9;
+
+    int contagem[4] = {0};
+    long eventos = 0;
+    for (int i = 0; i < n; i++) {
+        const ResultadoReproducao *r = &fila.resultados[i];
+        contagem[r->estado]++;
+        eventos += r->eventos;
+        if (r->estado == REPRODUCAO_DIVERGENTE) printf("%s: DIVERGÊNCIA: %s\n", caminhos[i], r->detalhe);
+        else if (r->estado == REPRODUCAO_ERRO) printf("%s: ERRO: %s\n", caminhos[i], r->detalhe);
+        else if (r->estado == REPRODUCAO_IGNORADA) printf("%s: ignorado (%s)\n", caminhos[i], r->detalhe);
+    }
+    printf("%d diário(s): %d conferem, %d divergente(s), %d com erro, %d ignorado(s)\n", n,
+           contagem[REPRODUCAO_OK], contagem[REPRODUCAO_DIVERGENTE], contagem[REPRODUCAO_ERRO],
+           contagem[REPRODUCAO_IGNORADA]);
+    printf("%ld eventos em %.3f s com %d thread(s): %.0f eventos/s\n", eventos, segundos,
+           iniciadas > 0 ? iniciadas : 1, segundos > 0 ? eventos / segundos : 0.0);
+    free(fila.resultados);
+    return contagem[REPRODUCAO_DIVERGENTE] + contagem[REPRODUCAO_ERRO];
+}
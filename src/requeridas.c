@@ -0,0 +1,117 @@
+#include "detective.h"
+
+/* ----------------------------- Funções Requeridas ----------------------------- */
+
+/**
+ * criarSala()
+ * Cria dinamicamente um cômodo com o nome e o id fornecidos.
+ * O nome não é copiado: deve vir do dicionário compartilhado (ou durar tanto
+ * quanto a sala). Retorna um ponteiro para Room alocado no pool de salas
+ * (liberar com liberarNo(&poolSalas, ...)).
+ */
+Room *criarSala(const char *name, int id) {
+    Room *r = alocarNo(&poolSalas);
+    r->id = id;
+    r->name = name;
+    r->andar = NULL;
+    r->left = r->right = NULL;
+    return r;
+}
+
+/**
+ * inserirPista()
+ * Insere uma pista na árvore BST de pistas em ordem lexicográfica.
+ * Evita inserção duplicada (se já existe, não insere).
+ * Retorna o nó raiz (possivelmente atualizado).
+ */
+ClueNode *inserirPista(ClueNode *root, const char *clue) {
+    if (!clue) return root;
+    if (!root) {
+        ClueNode *n = (ClueNode*)malloc(sizeof(ClueNode));
+        if (!n) { perror("malloc"); exit(EXIT_FAILURE); }
+        n->clue = strdup_safe(clue);
+        n->left = n->right = NULL;
+        return n;
+    }
+    int cmp = strcmp(clue, root->clue);
+    if (cmp == 0) return root; // já existe
+    if (cmp < 0) root->left = inserirPista(root->left, clue);
+    else root->right = inserirPista(root->right, clue);
+    return root;
+}
+
+/**
+ * buscarPista()
+ * Retorna 1 se a pista já está na BST, 0 caso contrário.
+ */
+int buscarPista(ClueNode *root, const char *clue) {
+    while (root) {
+        int cmp = strcmp(clue, root->clue);
+        if (cmp == 0) return 1;
+        root = cmp < 0 ? root->left : root->right;
+    }
+    return 0;
+}
+
+// Organização das cadeias das tabelas inicializadas daqui em diante (--backend tabela=...)
+int tabelaPistasPadrao = TABELA_ENCADEADA;
+
+unsigned int hash_func(const char *s) {
+    unsigned long h = 5381;
+    while (*s) h = ((h << 5) + h) + (unsigned char)(*s++);
+    return (unsigned int)(h % HASH_SIZE);
+}
+
+// Esvazia a tabela e fixa a organização das cadeias
+void inicializarTabelaPistas(TabelaPistas *table, int organizacao) {
+    for (int i = 0; i < HASH_SIZE; i++) table->baldes[i] = NULL;
+    table->organizacao = organizacao;
+}
+
+/**
+ * inserirNaHash()
+ * Insere uma associação pista -> suspeito na tabela hash.
+ * Não insere duplicatas de chave (substitui se já existir).
+ * Os textos não são copiados: devem vir do dicionário compartilhado.
+ */
+void inserirNaHash(TabelaPistas *table, const char *pista, const char *suspeito) {
+    if (!pista || !suspeito) return;
+    unsigned int idx = hash_func(pista);
+    HashEntry **elo = &table->baldes[idx];
+    while (*elo) {
+        int cmp = strcmp((*elo)->key, pista);
+        if (cmp == 0) {
+            // substitui o suspeito existente
+            (*elo)->suspect = suspeito;
+            return;
+        }
+        if (cmp > 0 && table->organizacao == TABELA_ORDENADA) break;
+        elo = &(*elo)->next;
+    }
+    // novo entry: na cabeça, ou na posição ordenada
+    if (table->organizacao == TABELA_ENCADEADA) elo = &table->baldes[idx];
+    HashEntry *e = alocarNo(&poolEntradasHash);
+    e->key = pista;
+    e->suspect = suspeito;
+    e->next = *elo;
+    *elo = e;
+}
+
+/**
+ * encontrarSuspeito()
+ * Consulta a tabela hash para encontrar o suspeito associado a uma pista.
+ * Retorna NULL se não encontrado.
+ */
+const char *encontrarSuspeito(const TabelaPistas *table, const char *pista) {
+    if (!pista) return NULL;
+    contarMetrica(MET_CONSULTAS_HASH);
+    unsigned int idx = hash_func(pista);
+    HashEntry *cur = table->baldes[idx];
+    while (cur) {
+        int cmp = strcmp(cur->key, pista);
+        if (cmp == 0) return cur->suspect;
+        if (cmp > 0 && table->organizacao == TABELA_ORDENADA) return NULL;   // já passou da posição
+        cur = cur->next;
+    }
+    return NULL;
+}
@@ -0,0 +1,171 @@
+#include "detective.h"
+
+/* ----------------------------- Sessões ----------------------------- */
+
+void freeClues(ClueNode *n);
+void freeCaderno(Caderno *c);
+
+Caderno *criarCaderno(void) {
+    Caderno *c = malloc(sizeof(Caderno));
+    if (!c) { perror("malloc"); exit(EXIT_FAILURE); }
+    inicializarCaderno(c);
+    c->refs = 1;
+    return c;
+}
+
+ClueNode *clonarPistas(const ClueNode *n) {
+    if (!n) return NULL;
+    ClueNode *copia = malloc(sizeof(ClueNode));
+    if (!copia) { perror("malloc"); exit(EXIT_FAILURE); }
+    copia->clue = strdup_safe(n->clue);
+    copia->left = clonarPistas(n->left);
+    copia->right = clonarPistas(n->right);
+    return copia;
+}
+
+void *duplicarMemoria(const void *origem, size_t bytes) {
+    if (!origem || bytes == 0) return NULL;
+    void *copia = malloc(bytes);
+    if (!copia) { perror("malloc"); exit(EXIT_FAILURE); }
+    memcpy(copia, origem, bytes);
+    return copia;
+}
+
+ListaIndices clonarLista(const ListaIndices *l) {
+    ListaIndices copia = { duplicarMemoria(l->itens, l->capacidade * sizeof(int)),
+                           l->total, l->capacidade };
+    return copia;
+}
+
+void copiarParaListaSaltos(const char *pista, void *destino) {
+    int nova;
+    inserirNaListaSaltos(destino, pista, &nova);
+}
+
+// Cópia profunda e exclusiva (refs = 1) de um caderno
+Caderno *clonarCaderno(const Caderno *c) {
+    Caderno *copia = criarCaderno();
+    copia->indice = c->indice;
+    copia->arvore = clonarPistas(c->arvore);
+    copia->radix.raiz = clonarRadix(c->radix.raiz);
+    copia->radix.total = c->radix.total;
+    percorrerListaSaltos((ListaSaltos*)&c->saltos, copiarParaListaSaltos, &copia->saltos);
+    copia->linha.eventos = duplicarMemoria(c->linha.eventos, c->linha.capacidade * sizeof(EventoPista));
+    copia->linha.total = c->linha.total;
+    copia->linha.capacidade = c->linha.capacidade;
+    copia->registros = duplicarMemoria(c->registros, c->capacidade * sizeof(RegistroPista));
+    copia->total = c->total;
+    copia->capacidade = c->capacidade;
+    if (c->capSuspeitos > 0) {
+        copia->suspeitos = malloc(c->capSuspeitos * sizeof(char*));
+        copia->porSuspeito = calloc(c->capSuspeitos, sizeof(ListaIndices));
+        if (!copia->suspeitos || !copia->porSuspeito) { perror("malloc"); exit(EXIT_FAILURE); }
+        copia->capSuspeitos = c->capSuspeitos;
+    }
+    copia->nSuspeitos = c->nSuspeitos;
+    for (int i = 0; i < c->nSuspeitos; i++) {
+        copia->suspeitos[i] = strdup_safe(c->suspeitos[i]);
+        copia->porSuspeito[i] = clonarLista(&c->porSuspeito[i]);
+    }
+    copia->placar = clonarPlacar(&c->placar);
+    if (c->nSalas > 0) {
+        copia->porSala = malloc(c->nSalas * sizeof(ListaIndices));
+        if (!copia->porSala) { perror("malloc"); exit(EXIT_FAILURE); }
+        for (int i = 0; i < c->nSalas; i++) copia->porSala[i] = clonarLista(&c->porSala[i]);
+        copia->nSalas = c->nSalas;
+    }
+    return copia;
+}
+
+void liberarCaderno(Caderno *c) {
+    if (--c->refs > 0) return;
+    freeCaderno(c);
+    free(c);
+}
+
+Sessao *criarSessao(Room *mansao) {
+    Sessao *s = malloc(sizeof(Sessao));
+    if (!s) { perror("malloc"); exit(EXIT_FAILURE); }
+    s->mansao = mansao;
+    s->atual = mansao;
+    s->movimento = 0;
+    s->caderno = criarCaderno();
+    s->caso = NULL;
+    s->diario = NULL;
+    s->autosave = NULL;
+    s->prefetcher = NULL;
+    contarMetrica(MET_SESSOES_CRIADAS);
+    return s;
+}
+
+/**
+ * bifurcarSessao()
+ * Cria uma nova sessão a partir de `s`. Custo constante: a mansão e o caderno
+ * passam a ser compartilhados, e o caderno só é copiado quando uma das sessões
+ * precisar modificá-lo (ver cadernoParaEscrita()).
+ */
+Sessao *bifurcarSessao(const Sessao *s) {
+    Sessao *f = malloc(sizeof(Sessao));
+    if (!f) { perror("malloc"); exit(EXIT_FAILURE); }
+    *f = *s;
+    f->caderno->refs++;
+    contarMetrica(MET_SESSOES_CRIADAS);
+    return f;
+}
+
+// Garante que o caderno da sessão não é compartilhado antes de uma escrita
+Caderno *cadernoParaEscrita(Sessao *s) {
+    if (s->caderno->refs > 1) {
+        Caderno *copia = clonarCaderno(s->caderno);
+        s->caderno->refs--;
+        s->caderno = copia;
+    }
+    return s->caderno;
+}
+
+void liberarSessao(Sessao *s) {
+    if (!s) return;
+    contarMetrica(MET_SESSOES_LIBERADAS);
+    liberarCaderno(s->caderno);
+    free(s);
+}
+
+/**
+ * adicionarPista()
+ * Função wrapper que registra a pista no caderno da sessão e informa o jogador.
+ * O caderno só é separado de bifurcações quando a pista é de fato nova.
+ */
+void adicionarPista(Transmissao *tx, Sessao *s, int pistaId, const char *clue,
+                    TabelaPistas *table) {
+    if (!clue) return;
+    emitir(tx, "\n> Pista encontrada: \"%s\"\n", clue);
+    if (!cadernoContemPista(s->caderno, clue) &&
+        registrarPista(cadernoParaEscrita(s), pistaId, clue, s->atual,
+                       encontrarSuspeito(table, clue), s->movimento)) {
+        emitir(tx, "Pista adicionada ao caderno do jogador.\n");
+        int lider = liderDoPlacar(&s->caderno->placar);
+        if (lider >= 0)
+            emitir(tx, "Suspeito mais provável: %s (%d pista(s)).\n", s->caderno->suspeitos[lider],
+                   s->caderno->placar.pontos[lider]);
+        emitir(tx, "\n");
+    } else {
+        emitir(tx, "Esta pista já está no caderno.\n\n");
+    }
+}
+
+#define PLACAR_EXIBIDOS 3
+
+// Mostra os suspeitos à frente no placar do caderno
+void mostrarPlacar(Transmissao *tx, const Caderno *c) {
+    int primeiros[PLACAR_EXIBIDOS];
+    int n = primeirosDoPlacar(&c->placar, primeiros, PLACAR_EXIBIDOS);
+    if (n == 0) {
+        emitir(tx, "Nenhuma pista aponta para um suspeito ainda.\n\n");
+        return;
+    }
+    emitir(tx, "\n--- Placar de suspeitos ---\n");
+    for (int i = 0; i < n; i++)
+        emitir(tx, "%d. %s: %d pista(s)\n", i + 1, c->suspeitos[primeiros[i]],
+               c->placar.pontos[primeiros[i]]);
+    emitir(tx, "\n");
+}
@@ -0,0 +1,164 @@
+#include "detective.h"
+
+/* ----------------------------- Transmissão para espectadores ----------------------------- */
+
+void liberarBloco(BlocoSaida *b) {
+    if (--b->refs == 0) free(b);
+}
+
+void removerEspectador(Transmissao *tx, int i) {
+    Espectador *e = &tx->espectadores[i];
+    for (int k = 0; k < e->nPendentes; k++) liberarBloco(e->pendentes[k]);
+    if (e->fd >= 0) close(e->fd);
+    tx->espectadores[i] = tx->espectadores[--tx->nEspectadores];
+}
+
+/**
+ * abrirEspectador()
+ * Abre o destino sem bloquear. Um FIFO sem leitor falha com ENXIO: retorna -1
+ * com errno preservado para que o chamador tente de novo mais tarde.
+ */
+int abrirEspectador(const char *caminho) {
+    return open(caminho, O_WRONLY | O_CREAT | O_APPEND | O_NONBLOCK, 0644);
+}
+
+/**
+ * enviarEspectadores()
+ * Envia a cada espectador seus blocos pendentes com uma única chamada writev()
+ * apontando diretamente para os blocos compartilhados (sem cópias). Escritas
+ * parciais são retomadas; com o destino cheio (EAGAIN) os blocos ficam
+ * pendentes para o próximo envio. Espectadores com erro de escrita são
+ * desconectados.
+ */
+void enviarEspectadores(Transmissao *tx) {
+    if (!tx) return;
+    for (int i = tx->nEspectadores - 1; i >= 0; i--) {
+        Espectador *e = &tx->espectadores[i];
+        if (e->fd < 0) {
+            e->fd = abrirEspectador(e->caminho);
+            if (e->fd < 0 && errno != ENXIO) { perror(e->caminho); removerEspectador(tx, i); }
+            continue;   // recém-conectado: recebe a partir do próximo bloco
+        }
+        while (e->nPendentes > 0) {
+            struct iovec iov[MAX_PENDENTES];
+            for (int k = 0; k < e->nPendentes; k++) {
+                iov[k].iov_base = e->pendentes[k]->dados;
+                iov[k].iov_len = e->pendentes[k]->tamanho;
+            }
+            iov[0].iov_base = (char*)iov[0].iov_base + e->enviado;
+            iov[0].iov_len -= e->enviado;
+
+            ssize_t n = writev(e->fd, iov, e->nPendentes);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (n < 0) { removerEspectador(tx, i); break; }
+
+            // descarta os blocos completamente enviados
+            size_t resto = (size_t)n + e->enviado;
+            int k = 0;
+            while (k < e->nPendentes && resto >= e->pendentes[k]->tamanho) {
+                resto -= e->pendentes[k]->tamanho;
+                liberarBloco(e->pendentes[k]);
+                k++;
+            }
+            memmove(e->pendentes, e->pendentes + k, (e->nPendentes - k) * sizeof(BlocoSaida*));
+            e->nPendentes -= k;
+            e->enviado = resto;
+        }
+    }
+}
+
+/**
+ * distribuirBloco()
+ * Entrega uma referência do bloco a cada espectador conectado e solta a do
+ * chamador. Se a fila de algum espectador estiver cheia, tenta esvaziá-la; o
+ * espectador que continuar sem espaço (leitor parado) é desconectado.
+ */
+void distribuirBloco(Transmissao *tx, BlocoSaida *b) {
+    for (int i = 0; i < tx->nEspectadores; i++) {
+        if (tx->espectadores[i].nPendentes == MAX_PENDENTES) { enviarEspectadores(tx); break; }
+    }
+    for (int i = tx->nEspectadores - 1; i >= 0; i--) {
+        Espectador *e = &tx->espectadores[i];
+        if (e->fd < 0) continue;
+        if (e->nPendentes == MAX_PENDENTES) {
+            fprintf(stderr, "Espectador %s desconectado: não acompanha a transmissão.\n", e->caminho);
+            removerEspectador(tx, i);
+            continue;
+        }
+        b->refs++;
+        e->pendentes[e->nPendentes++] = b;
+    }
+    liberarBloco(b);
+}
+
+/**
+ * emitir()
+ * Formata a saída da sessão uma única vez. O jogador a recebe por stdout; se
+ * houver espectadores, o texto vai para um BlocoSaida compartilhado e cada um
+ * recebe apenas uma referência, enviada no próximo enviarEspectadores().
+ */
+void emitir(Transmissao *tx, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    if (!tx || tx->nEspectadores == 0) {
+        vprintf(fmt, ap);
+        va_end(ap);
+        return;
+    }
+    char tmp[512];
+    va_list copia;
+    va_copy(copia, ap);
+    int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+    if (n < 0) { va_end(copia); return; }
+
+    BlocoSaida *b = malloc(sizeof(BlocoSaida) + (size_t)n + 1);
+    if (!b) { perror("malloc"); exit(EXIT_FAILURE); }
+    if ((size_t)n < sizeof(tmp)) memcpy(b->dados, tmp, (size_t)n + 1);
+    else vsnprintf(b->dados, (size_t)n + 1, fmt, copia);
+    va_end(copia);
+    b->tamanho = (size_t)n;
+    b->refs = 1;
+
+    fwrite(b->dados, 1, b->tamanho, stdout);
+    distribuirBloco(tx, b);
+}
+
+/**
+ * transmitirEspectadores()
+ * Envia dados apenas aos espectadores (o jogador local não os recebe).
+ */
+void transmitirEspectadores(Transmissao *tx, const void *dados, size_t tamanho) {
+    if (!tx || tx->nEspectadores == 0) return;
+    BlocoSaida *b = malloc(sizeof(BlocoSaida) + tamanho);
+    if (!b) { perror("malloc"); exit(EXIT_FAILURE); }
+    memcpy(b->dados, dados, tamanho);
+    b->tamanho = tamanho;
+    b->refs = 1;
+    distribuirBloco(tx, b);
+}
+
+/**
+ * inscreverEspectador()
+ * Abre o destino (arquivo ou FIFO) e o inscreve na transmissão. Um FIFO ainda
+ * sem leitor não bloqueia o jogo: fica inscrito e é aberto quando o leitor
+ * aparecer. `caminho` deve durar tanto quanto a transmissão.
+ * Retorna 0 em caso de sucesso e -1 em caso de erro.
+ */
+int inscreverEspectador(Transmissao *tx, const char *caminho) {
+    if (tx->nEspectadores == MAX_ESPECTADORES) return -1;
+    int fd = abrirEspectador(caminho);
+    if (fd < 0 && errno != ENXIO) { perror(caminho); return -1; }
+    Espectador *e = &tx->espectadores[tx->nEspectadores++];
+    e->fd = fd;
+    e->caminho = caminho;
+    e->nPendentes = 0;
+    e->enviado = 0;
+    return 0;
+}
+
+void encerrarTransmissao(Transmissao *tx) {
+    enviarEspectadores(tx);
+    while (tx->nEspectadores > 0) removerEspectador(tx, tx->nEspectadores - 1);
+}
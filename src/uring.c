@@ -0,0 +1,211 @@
+#include "detective.h"
+
+/* ----------------------------- E/S assíncrona (io_uring) ----------------------------- */
+
+#ifdef TEM_IO_URING
+static int entrarUring(AnelUring *a, unsigned submeter, unsigned esperar) {
+    a->chamadas++;
+    return (int)syscall(__NR_io_uring_enter, a->fd, submeter, esperar,
+                        esperar ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+}
+
+// Escreve de forma síncrona o que o kernel não conseguiu gravar
+static void recuperarEscrita(AnelUring *a, int i, long gravados) {
+    if (gravados < 0) {
+        fprintf(stderr, "diário (io_uring): %s\n", strerror((int)-gravados));
+        gravados = 0;
+    }
+    size_t feito = (size_t)gravados;
+    while (feito < a->tamanho[i]) {
+        a->chamadas++;
+        ssize_t n = pwrite(a->fdDestino[i], a->buffers[i] + feito, a->tamanho[i] - feito,
+                           a->deslocamento[i] + (off_t)feito);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) { perror("diário"); break; }
+        feito += (size_t)n;
+    }
+}
+
+// Consome as conclusões disponíveis, liberando os buffers (sem chamada de sistema)
+static void colherUring(AnelUring *a) {
+    unsigned cabeca = *a->cqCabeca;
+    unsigned cauda = __atomic_load_n(a->cqCauda, __ATOMIC_ACQUIRE);
+    for (; cabeca != cauda; cabeca++) {
+        const struct io_uring_cqe *cqe = &a->cqes[cabeca & *a->cqMascara];
+        int i = (int)cqe->user_data;
+        if (cqe->res != (int)a->tamanho[i]) recuperarEscrita(a, i, cqe->res);
+        a->ocupado[i] = 0;
+        a->emVoo--;
+    }
+    __atomic_store_n(a->cqCabeca, cabeca, __ATOMIC_RELEASE);
+}
+
+// Retira do anel as entradas que o kernel não consumiu e grava seus buffers
+// com write(2)
+static void recuperarNaoSubmetidas(AnelUring *a) {
+    unsigned cabeca = __atomic_load_n(a->sqCabeca, __ATOMIC_ACQUIRE);
+    unsigned cauda = *a->sqCauda;
+    for (unsigned k = cabeca; k != cauda; k++) {
+        int i = (int)a->sqes[a->sqIndices[k & *a->sqMascara]].user_data;
+        recuperarEscrita(a, i, 0);
+        a->ocupado[i] = 0;
+        a->emVoo--;
+    }
+    __atomic_store_n(a->sqCauda, cabeca, __ATOMIC_RELEASE);
+    a->naoSubmetidas = 0;
+}
+
+// Sem io_uring_enter, espera as escritas já aceitas pelo kernel olhando o anel
+// de conclusões; cada pausa volta ao espaço de usuário, onde o kernel publica
+// as conclusões pendentes. Os buffers só são reaproveitados depois disso.
+static void esperarConclusoes(AnelUring *a) {
+    struct timespec pausa = { 0, 100000 };
+    for (colherUring(a); a->emVoo > 0; colherUring(a)) nanosleep(&pausa, NULL);
+}
+
+/**
+ * submeterUring()
+ * Submete as entradas pendentes e, com `esperar`, aguarda uma conclusão.
+ * Desconta de naoSubmetidas apenas o que o kernel aceitou e repete enquanto
+ * sobrar algo. Em erro definitivo as pendentes são gravadas com write(2) e
+ * retorna -1.
+ */
+static int submeterUring(AnelUring *a, unsigned esperar) {
+    for (;;) {
+        unsigned pendentes = a->naoSubmetidas;
+        int r = entrarUring(a, pendentes, esperar);
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0 || (pendentes > 0 && r == 0)) {
+            if (r < 0) perror("io_uring_enter");
+            else fprintf(stderr, "io_uring_enter: nenhuma escrita submetida\n");
+            recuperarNaoSubmetidas(a);
+            return -1;
+        }
+        a->naoSubmetidas -= (unsigned)r < pendentes ? (unsigned)r : pendentes;
+        if (a->naoSubmetidas == 0) return 0;
+    }
+}
+
+/**
+ * criarAnelUring()
+ * Cria o anel e registra URING_BUFFERS buffers de `tamBuffer` bytes. Retorna
+ * NULL se io_uring não estiver disponível (kernel antigo, bloqueado por
+ * seccomp/sysctl etc.); nesse caso o chamador usa write(2).
+ */
+AnelUring *criarAnelUring(size_t tamBuffer) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int fd = (int)syscall(__NR_io_uring_setup, URING_BUFFERS, &p);
+    if (fd < 0) return NULL;
+
+    AnelUring *a = calloc(1, sizeof(AnelUring));
+    if (!a) { perror("calloc"); exit(EXIT_FAILURE); }
+    a->fd = fd;
+    a->tamMapaSq = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    a->tamMapaCq = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    a->tamSqes = p.sq_entries * sizeof(struct io_uring_sqe);
+    a->mapaSq = mmap(NULL, a->tamMapaSq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     fd, IORING_OFF_SQ_RING);
+    a->mapaCq = mmap(NULL, a->tamMapaCq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     fd, IORING_OFF_CQ_RING);
+    a->sqes = mmap(NULL, a->tamSqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   fd, IORING_OFF_SQES);
+    if (a->mapaSq == MAP_FAILED || a->mapaCq == MAP_FAILED || a->sqes == MAP_FAILED) {
+        if (a->mapaSq != MAP_FAILED) munmap(a->mapaSq, a->tamMapaSq);
+        if (a->mapaCq != MAP_FAILED) munmap(a->mapaCq, a->tamMapaCq);
+        if (a->sqes != MAP_FAILED) munmap(a->sqes, a->tamSqes);
+        close(fd);
+        free(a);
+        return NULL;
+    }
+    uint8_t *sq = a->mapaSq, *cq = a->mapaCq;
+    a->sqCabeca = (unsigned*)(sq + p.sq_off.head);
+    a->sqCauda = (unsigned*)(sq + p.sq_off.tail);
+    a->sqMascara = (unsigned*)(sq + p.sq_off.ring_mask);
+    a->sqIndices = (unsigned*)(sq + p.sq_off.array);
+    a->cqCabeca = (unsigned*)(cq + p.cq_off.head);
+    a->cqCauda = (unsigned*)(cq + p.cq_off.tail);
+    a->cqMascara = (unsigned*)(cq + p.cq_off.ring_mask);
+    a->cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+
+    struct iovec iov[URING_BUFFERS];
+    a->tamBuffer = tamBuffer;
+    for (int i = 0; i < URING_BUFFERS; i++) {
+        a->buffers[i] = malloc(tamBuffer);
+        if (!a->buffers[i]) { perror("malloc"); exit(EXIT_FAILURE); }
+        iov[i].iov_base = a->buffers[i];
+        iov[i].iov_len = tamBuffer;
+    }
+    if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iov, URING_BUFFERS) < 0) {
+        for (int i = 0; i < URING_BUFFERS; i++) free(a->buffers[i]);
+        munmap(a->mapaSq, a->tamMapaSq);
+        munmap(a->mapaCq, a->tamMapaCq);
+        munmap(a->sqes, a->tamSqes);
+        close(fd);
+        free(a);
+        return NULL;
+    }
+    return a;
+}
+
+/**
+ * bufferLivreUring()
+ * Retorna o índice de um buffer registrado livre, esperando uma conclusão se
+ * todos estiverem em voo.
+ */
+int bufferLivreUring(AnelUring *a) {
+    for (;;) {
+        colherUring(a);
+        for (int i = 0; i < URING_BUFFERS; i++)
+            if (!a->ocupado[i]) return i;
+        if (submeterUring(a, 1) != 0) esperarConclusoes(a);
+    }
+}
+
+/**
+ * enviarUring()
+ * Enfileira a escrita do buffer `i` em `fd` na posição dada. As escritas são
+ * submetidas em lotes de URING_LOTE, em uma única chamada io_uring_enter.
+ */
+void enviarUring(AnelUring *a, int i, int fd, size_t tamanho, off_t deslocamento) {
+    unsigned cauda = *a->sqCauda;
+    unsigned pos = cauda & *a->sqMascara;
+    struct io_uring_sqe *sqe = &a->sqes[pos];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = fd;
+    sqe->addr = (uintptr_t)a->buffers[i];
+    sqe->len = (unsigned)tamanho;
+    sqe->off = (uint64_t)deslocamento;
+    sqe->buf_index = (uint16_t)i;
+    sqe->user_data = (uint64_t)i;
+    a->sqIndices[pos] = pos;
+    __atomic_store_n(a->sqCauda, cauda + 1, __ATOMIC_RELEASE);
+
+    a->ocupado[i] = 1;
+    a->tamanho[i] = tamanho;
+    a->deslocamento[i] = deslocamento;
+    a->fdDestino[i] = fd;
+    a->emVoo++;
+    if (++a->naoSubmetidas >= URING_LOTE) submeterUring(a, 0);
+}
+
+// Submete o que falta e espera todas as escritas em voo
+void drenarUring(AnelUring *a) {
+    while (a->emVoo > 0) {
+        if (submeterUring(a, 1) != 0) { esperarConclusoes(a); return; }
+        colherUring(a);
+    }
+}
+
+void liberarAnelUring(AnelUring *a) {
+    if (!a) return;
+    drenarUring(a);
+    munmap(a->mapaSq, a->tamMapaSq);
+    munmap(a->mapaCq, a->tamMapaCq);
+    munmap(a->sqes, a->tamSqes);
+    close(a->fd);   // também desfaz o registro dos buffers
+    for (int i = 0; i < URING_BUFFERS; i++) free(a->buffers[i]);
+    free(a);
+}
+#endif
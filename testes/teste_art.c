@@ -0,0 +1,120 @@
+#include "testes.h"
+
+/* ----------------------------- Árvore radix adaptativa ----------------------------- */
+
+#define ART_CHAVES 6000
+
+static int compararTextos(const void *a, const void *b) {
+    return strcmp(*(const char *const*)a, *(const char *const*)b);
+}
+
+typedef struct {
+    const char **esperadas;
+    int n, visitadas, divergencias;
+} Percurso;
+
+static void visitarEmOrdem(const char *pista, void *ctx) {
+    Percurso *p = ctx;
+    if (p->visitadas >= p->n || strcmp(pista, p->esperadas[p->visitadas]) != 0) p->divergencias++;
+    p->visitadas++;
+}
+
+// A travessia deve produzir exatamente as chaves ordenadas por strcmp
+static void conferirOrdem(const NoArt *raiz, const char **ordenadas, int n) {
+    Percurso p = { ordenadas, n, 0, 0 };
+    percorrerRadix(raiz, visitarEmOrdem, &p);
+    VERIFICAR(p.visitadas == n && p.divergencias == 0);
+}
+
+static void contarTipos(NoArt *n, int *porTipo) {
+    if (!n || ehFolhaArt(n)) return;
+    porTipo[n->tipo]++;
+    int q;
+    NoArt **filhos = filhosArt(n, &q);
+    for (int i = 0; i < q; i++) contarTipos(filhos[i], porTipo);
+}
+
+void testarArt(void) {
+    uint64_t semente = 11;
+    char **chaves = malloc(ART_CHAVES * sizeof(char*));
+    if (!chaves) { perror("malloc"); exit(EXIT_FAILURE); }
+    int n = 0;
+
+    // todos os primeiros bytes possíveis: a raiz precisa crescer até 256 filhos
+    for (int c = 1; c < 256; c++) {
+        char k[3] = { (char)c, 'x', '\0' };
+        chaves[n++] = strdup(k);
+    }
+    // 30 continuações depois de "m": nó de 48 filhos
+    for (int c = 'A'; c < 'A' + 30; c++) {
+        char k[3] = { 'm', (char)c, '\0' };
+        chaves[n++] = strdup(k);
+    }
+    // chaves que são prefixo umas das outras, inclusive a vazia
+    static const char *encadeadas[] = { "", "a", "ab", "abc", "abcd", "abcdefghijklmnop", "abcdefghijklmnopq" };
+    for (int i = 0; i < N_ELEMENTOS(encadeadas); i++) chaves[n++] = strdup(encadeadas[i]);
+    // prefixos comuns maiores que ART_PREFIXO_MAX, com acentos (bytes acima de 127)
+    for (int i = 0; i < 500; i++) {
+        char k[64];
+        snprintf(k, sizeof(k), "Pegada de lama perto da janela da cozinha nº %d", i);
+        chaves[n++] = strdup(k);
+    }
+    // alfabeto pequeno gera muitos ramos curtos e duplicatas
+    while (n < ART_CHAVES) {
+        char k[16];
+        int tam = 1 + (int)(proximoAleatorio(&semente) % (sizeof(k) - 1));
+        for (int i = 0; i < tam; i++) k[i] = (char)('a' + proximoAleatorio(&semente) % 4);
+        k[tam] = '\0';
+        chaves[n++] = strdup(k);
+    }
+    for (int i = 0; i < n; i++) if (!chaves[i]) { perror("strdup"); exit(EXIT_FAILURE); }
+
+    // referência: chaves distintas em ordem
+    const char **ordenadas = malloc(n * sizeof(char*));
+    if (!ordenadas) { perror("malloc"); exit(EXIT_FAILURE); }
+    memcpy(ordenadas, chaves, n * sizeof(char*));
+    qsort(ordenadas, n, sizeof(char*), compararTextos);
+    int distintas = 0;
+    for (int i = 0; i < n; i++)
+        if (distintas == 0 || strcmp(ordenadas[i], ordenadas[distintas - 1]) != 0) ordenadas[distintas++] = ordenadas[i];
+
+    ArvoreRadix arvore = { NULL, 0 };
+    int novas = 0;
+    for (int i = 0; i < n; i++) {
+        int antes = buscarNaRadix(&arvore, chaves[i]);
+        int nova = inserirNaRadix(&arvore, chaves[i]);
+        VERIFICAR(nova == !antes);
+        novas += nova;
+        VERIFICAR(buscarNaRadix(&arvore, chaves[i]));
+    }
+    VERIFICAR(novas == distintas && arvore.total == distintas);
+    for (int i = 0; i < n; i++) VERIFICAR(buscarNaRadix(&arvore, chaves[i]));
+
+    // ausentes: extensões e cortes das chaves, divergência dentro do prefixo comprimido
+    for (int i = 0; i < n; i++) {
+        char k[80];
+        snprintf(k, sizeof(k), "%s!", chaves[i]);
+        VERIFICAR(!buscarNaRadix(&arvore, k));
+    }
+    VERIFICAR(!buscarNaRadix(&arvore, "abcde"));
+    VERIFICAR(!buscarNaRadix(&arvore, "Pegada de lama perto"));
+    VERIFICAR(!buscarNaRadix(&arvore, "Pegada de LAMA perto da janela da cozinha nº 1"));
+
+    int porTipo[4] = { 0 };
+    contarTipos(arvore.raiz, porTipo);
+    VERIFICAR(porTipo[ART_NO4] > 0 && porTipo[ART_NO16] > 0 && porTipo[ART_NO48] > 0 &&
+              porTipo[ART_NO256] > 0);
+    conferirOrdem(arvore.raiz, ordenadas, distintas);
+
+    // a cópia é independente do original
+    NoArt *copia = clonarRadix(arvore.raiz);
+    liberarRadix(arvore.raiz);
+    ArvoreRadix clonada = { copia, distintas };
+    conferirOrdem(copia, ordenadas, distintas);
+    for (int i = 0; i < n; i++) VERIFICAR(buscarNaRadix(&clonada, chaves[i]));
+    liberarRadix(copia);
+
+    for (int i = 0; i < n; i++) free(chaves[i]);
+    free(chaves);
+    free(ordenadas);
+}
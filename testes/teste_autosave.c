@@ -0,0 +1,153 @@
+#include "testes.h"
+
+/* ----------------------------- Salvamento automático ----------------------------- */
+
+// Coleta as pistas da sala atual (mesma regra da exploração)
+static void examinar(Sessao *s) {
+    const IndiceProcedencia *proc = &s->caso->procedencia;
+    int nPistas;
+    const int *pistas = pistasDaSala(proc, s->atual->id, &nPistas);
+    for (int i = 0; i < nPistas; i++) {
+        const char *texto = proc->pistas[pistas[i]];
+        if (!cadernoContemPista(s->caderno, texto))
+            registrarPista(cadernoParaEscrita(s), pistas[i], texto, s->atual,
+                           encontrarSuspeito(&s->caso->tabela, texto), s->movimento);
+    }
+}
+
+static int mesmaSessao(const Sessao *a, const Sessao *b) {
+    if (a->caso != b->caso || a->atual != b->atual || a->movimento != b->movimento ||
+        a->caderno->total != b->caderno->total) return 0;
+    for (int i = 0; i < a->caderno->total; i++) {
+        const RegistroPista *x = &a->caderno->registros[i], *y = &b->caderno->registros[i];
+        if (x->pista != y->pista || x->sala != y->sala || x->andar != y->andar ||
+            x->movimento != y->movimento) return 0;
+    }
+    return resumoDoCaderno(a->caderno) == resumoDoCaderno(b->caderno);
+}
+
+// O arquivo restaurado deve ser igual ao que foi gravado por último
+static void conferirArquivo(PacoteCasos *pc, const char *caminho, const AutoSalvamento *a, const Sessao *s) {
+    Sessao *t = carregarJogo(pc, caminho);
+    VERIFICAR(t != NULL);
+    if (!t) return;
+    VERIFICAR(t->movimento == a->movimentoSalvo && t->caderno->total == a->totalSalvo);
+    if (s->movimento == a->movimentoSalvo && s->caderno->total == a->totalSalvo)
+        VERIFICAR(mesmaSessao(s, t));
+    liberarSessao(t);
+}
+
+// Movimento aleatório; numa sala sem saída volta à entrada (também conta como movimento)
+static void mover(Sessao *s, uint64_t *semente) {
+    Room *r = s->atual;
+    Room *prox = (proximoAleatorio(semente) & 1) ? r->left : r->right;
+    if (!prox) prox = r->left ? r->left : r->right;
+    s->atual = prox ? prox : s->mansao;
+    s->movimento++;
+    examinar(s);
+}
+
+// Retorna quantos checkpoints periódicos (após uma sequência de deltas) foram gravados
+static int partidaComAutosave(PacoteCasos *pc, Caso *caso, int intervalo, uint64_t *semente) {
+    char caminho[64];
+    arquivoTemporario(caminho, sizeof(caminho));
+    Sessao *s = criarSessao(entradaPropriedade(caso->propriedade));
+    s->caso = caso;
+    examinar(s);
+    AutoSalvamento *a = criarAutoSalvamento(caminho, intervalo);
+    autoSalvar(a, s, 1);
+    conferirArquivo(pc, caminho, a, s);
+
+    Sessao *marcada = NULL;
+    int checkpointsPeriodicos = 0;
+    for (int passo = 0; passo < 120; passo++) {
+        // ponto de retorno marcado e retomado de tempos em tempos (o caderno encolhe)
+        if (passo % 25 == 5 && !marcada) marcada = bifurcarSessao(s);
+        int voltou = passo % 25 == 20 && marcada;
+        if (voltou) {
+            liberarCaderno(s->caderno);
+            *s = *marcada;
+            free(marcada);
+            marcada = NULL;
+            a->precisaCompleto = 1;
+        }
+        int deltas = a->deltasDesdeCompleto;
+        mover(s, semente);
+        autoSalvar(a, s, 0);
+        if (deltas > 0 && a->deltasDesdeCompleto == 0 && !voltou) checkpointsPeriodicos++;
+        conferirArquivo(pc, caminho, a, s);
+    }
+    autoSalvar(a, s, 1);
+    conferirArquivo(pc, caminho, a, s);
+    encerrarAutoSalvamento(a);
+
+    // delta completo apontando para uma sala inexistente
+    uint8_t delta[16], *p = delta;
+    *p++ = 'D';
+    serializarVarint(&p, 100000);
+    serializarVarint(&p, 1);
+    serializarVarint(&p, 0);
+    uint8_t bloco[64];
+    size_t tam = montarBloco(delta, (uint32_t)(p - delta), bloco);
+
+    // gravação interrompida no meio do último delta: o delta é ignorado
+    FILE *f = fopen(caminho, "ab");
+    if (f) { fwrite(bloco, tam - 2, 1, f); fclose(f); }
+    Sessao *t = carregarJogo(pc, caminho);
+    VERIFICAR(t && mesmaSessao(s, t));
+    if (t) liberarSessao(t);
+
+    // o mesmo delta gravado por inteiro invalida o arquivo
+    a = criarAutoSalvamento(caminho, 1);
+    autoSalvar(a, s, 1);
+    VERIFICAR(fwrite(bloco, tam, 1, a->arquivo) == 1 && fflush(a->arquivo) == 0);
+    VERIFICAR(carregarJogo(pc, caminho) == NULL);
+    encerrarAutoSalvamento(a);
+
+    if (marcada) liberarSessao(marcada);
+    liberarSessao(s);
+    remove(caminho);
+    return checkpointsPeriodicos;
+}
+
+// Delta com uma pista na sala de entrada; `pista` vem direto do arquivo
+static int aplicarDeltaComPista(Caso *caso, uint32_t pista) {
+    Sessao *s = criarSessao(entradaPropriedade(caso->propriedade));
+    s->caso = caso;
+    uint8_t delta[32], *p = delta;
+    serializarVarint(&p, (uint32_t)s->atual->id);
+    serializarVarint(&p, 1);
+    serializarVarint(&p, 1);
+    serializarVarint(&p, pista);
+    serializarVarint(&p, (uint32_t)s->atual->id);
+    serializarVarint(&p, 1);
+    int r = aplicarDelta(s, delta, (size_t)(p - delta));
+    if (r == 0) VERIFICAR(s->caderno->total == 1 && s->movimento == 1);
+    else VERIFICAR(s->caderno->total == 0 && s->movimento == 0);
+    liberarSessao(s);
+    return r;
+}
+
+// Ids de pista fora da faixa (inclusive os que viram negativos como int) são recusados
+static void testarPistaForaDaFaixa(Caso *caso) {
+    uint32_t nPistas = (uint32_t)caso->procedencia.nPistas;
+    VERIFICAR(aplicarDeltaComPista(caso, 0) == 0);
+    VERIFICAR(aplicarDeltaComPista(caso, nPistas - 1) == 0);
+    VERIFICAR(aplicarDeltaComPista(caso, nPistas) == -1);
+    VERIFICAR(aplicarDeltaComPista(caso, 0x7fffffffu) == -1);
+    VERIFICAR(aplicarDeltaComPista(caso, 0x80000000u) == -1);
+    VERIFICAR(aplicarDeltaComPista(caso, UINT32_MAX) == -1);
+}
+
+void testarAutosave(void) {
+    PacoteCasos *pc = carregarPacote(CASOS, N_CASOS);
+    uint64_t semente = 7;
+    int checkpointsPeriodicos = 0;
+    for (int i = 0; i < pc->nCasos; i++) {
+        checkpointsPeriodicos += partidaComAutosave(pc, &pc->casos[i], 1, &semente);
+        checkpointsPeriodicos += partidaComAutosave(pc, &pc->casos[i], 3, &semente);
+    }
+    VERIFICAR(checkpointsPeriodicos > 0);
+    for (int i = 0; i < pc->nCasos; i++) testarPistaForaDaFaixa(&pc->casos[i]);
+    liberarPacote(pc);
+}
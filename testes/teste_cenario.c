@@ -0,0 +1,114 @@
+#include "testes.h"
+
+/* ----------------------------- Construção do cenário ----------------------------- */
+
+// O que se sabe de uma sala pelo seu id
+typedef struct {
+    const char *nome;     // internado no dicionário: sobrevive ao descarregamento
+    int nPistas;
+    char *descricao;
+} DadosSala;
+
+static void registrarSalas(Caso *c, DadosSala *dados, int *vistas) {
+    Propriedade *p = c->propriedade;
+    for (int b = 0; b < p->def->nPredios; b++)
+        for (int a = 0; a < p->def->predios[b].nAndares; a++) {
+            Andar *andar = &p->predios[b].andares[a];
+            for (int i = 0; i < andar->def->nSalas; i++) {
+                Room *r = andar->salas[i];
+                VERIFICAR(r->id == andar->primeiraSala + i && r->id >= 0 && r->id < p->nSalas);
+                if (r->id < 0 || r->id >= p->nSalas) continue;
+                vistas[r->id]++;
+                dados[r->id].nome = r->name;
+                pistasDaSala(&c->procedencia, r->id, &dados[r->id].nPistas);
+                const char *d = descricaoDaSala(&c->descricoes, r->id);
+                dados[r->id].descricao = d ? strdup_safe(d) : NULL;
+            }
+        }
+}
+
+// Descarrega todos os andares e os recarrega em ordem inversa à da planta
+static void recarregarAndares(Propriedade *p) {
+    for (int b = 0; b < p->def->nPredios; b++)
+        for (int a = 0; a < p->def->predios[b].nAndares; a++) descarregarAndar(&p->predios[b].andares[a]);
+    for (int b = p->def->nPredios - 1; b >= 0; b--)
+        for (int a = p->def->predios[b].nAndares - 1; a >= 0; a--) carregarAndar(&p->predios[b].andares[a]);
+}
+
+// Ids, pistas e descrições de cada sala sobrevivem a um ciclo de descarga e recarga
+static void testarRecarga(Caso *c) {
+    Propriedade *p = c->propriedade;
+    DadosSala *dados = calloc(p->nSalas, sizeof(DadosSala));
+    int *vistas = calloc(p->nSalas, sizeof(int));
+    if (!dados || !vistas) { perror("calloc"); exit(EXIT_FAILURE); }
+    registrarSalas(c, dados, vistas);
+    for (int id = 0; id < p->nSalas; id++) VERIFICAR(vistas[id] == 1);
+
+    for (int ciclo = 0; ciclo < 2; ciclo++) {
+        recarregarAndares(p);
+        Room *entrada = entradaPropriedade(p);
+        for (int id = 0; id < p->nSalas; id++) {
+            Room *r = buscarSala(entrada, dados[id].nome);
+            VERIFICAR(r && r->id == id);
+            int n;
+            pistasDaSala(&c->procedencia, id, &n);
+            VERIFICAR(n == dados[id].nPistas);
+            const char *d = descricaoDaSala(&c->descricoes, id);
+            VERIFICAR(d ? dados[id].descricao && strcmp(d, dados[id].descricao) == 0 : !dados[id].descricao);
+        }
+    }
+    for (int id = 0; id < p->nSalas; id++) free(dados[id].descricao);
+    free(dados);
+    free(vistas);
+}
+
+static int salasDaPlanta(const DefPropriedade *planta) {
+    int n = 0;
+    for (int b = 0; b < planta->nPredios; b++)
+        for (int a = 0; a < planta->predios[b].nAndares; a++) n += planta->predios[b].andares[a].nSalas;
+    return n;
+}
+
+// Cada caso enxerga a própria planta: salas, pistas e suspeitos conforme a definição
+static void testarPlanta(PacoteCasos *pc, Caso *c) {
+    const DefCaso *def = c->def;
+    Propriedade *p = c->propriedade;
+    VERIFICAR(p->def == def->planta && p->nSalas == salasDaPlanta(def->planta));
+    for (int i = 0; i < pc->nCasos; i++)
+        VERIFICAR((pc->casos[i].propriedade == p) == (pc->casos[i].def->planta == def->planta));
+    VERIFICAR(buscarCaso(pc, def->id) == c);
+
+    Room *entrada = entradaPropriedade(p);
+    for (int i = 0; i < def->nPistas; i++) {
+        Room *r = buscarSala(entrada, def->pistas[i].sala);
+        VERIFICAR(r != NULL);
+        if (!r) continue;
+        int n, achou = 0;
+        const int *pistas = pistasDaSala(&c->procedencia, r->id, &n);
+        for (int k = 0; k < n; k++) achou |= strcmp(c->procedencia.pistas[pistas[k]], def->pistas[i].pista) == 0;
+        VERIFICAR(achou);
+    }
+    for (int i = 0; i < def->nSuspeitos; i++) {
+        const char *s = encontrarSuspeito(&c->tabela, def->suspeitos[i].pista);
+        VERIFICAR(s && strcmp(s, def->suspeitos[i].suspeito) == 0);
+    }
+}
+
+void testarCenario(void) {
+    PacoteCasos *pc = carregarPacote(CASOS, N_CASOS);
+    for (int i = 0; i < pc->nCasos; i++) testarPlanta(pc, &pc->casos[i]);
+
+    // o farol numera as próprias salas a partir de 0, independente da mansão
+    Caso *farol = buscarCaso(pc, "farol"), *mansao = buscarCaso(pc, "mansao");
+    VERIFICAR(farol && mansao && farol->propriedade != mansao->propriedade);
+    if (farol && mansao) {
+        VERIFICAR(farol->propriedade->nSalas == 7 && mansao->propriedade->nSalas != 7);
+        Room *lanterna = buscarSala(entradaPropriedade(farol->propriedade), "Lanterna");
+        VERIFICAR(lanterna && lanterna->id == 6);
+        VERIFICAR(entradaPropriedade(farol->propriedade)->id == 0);
+        VERIFICAR(!buscarSala(entradaPropriedade(mansao->propriedade), "Lanterna"));
+    }
+
+    for (int i = 0; i < pc->nCasos; i++) testarRecarga(&pc->casos[i]);
+    liberarPacote(pc);
+}
@@ -0,0 +1,133 @@
+#include "testes.h"
+
+/* ----------------------------- Linha do tempo ----------------------------- */
+
+// Faixas de movimentos conferidas com um filtro linear sobre os eventos
+static void testarFaixas(uint64_t *semente) {
+    LinhaDoTempo l = { NULL, 0, 0 };
+    int movimento = 0;
+    for (int i = 0; i < 300; i++) {
+        movimento += (int)(proximoAleatorio(semente) % 4);   // repetições e lacunas
+        anexarEvento(&l, i, movimento);
+    }
+    int erros = 0;
+    for (int a = -2; a <= movimento + 2; a++)
+        for (int b = a - 1; b <= movimento + 2; b++) {
+            int primeiro = -1, esperados = 0;
+            for (int i = 0; i < l.total; i++)
+                if (l.eventos[i].movimento >= a && l.eventos[i].movimento <= b) {
+                    if (primeiro < 0) primeiro = i;
+                    esperados++;
+                }
+            const EventoPista *ev;
+            int n = pistasEntreMovimentos(&l, a, b, &ev);
+            erros += n != esperados || (n > 0 && ev != l.eventos + primeiro);
+        }
+    VERIFICAR(erros == 0);
+
+    const EventoPista *ev;
+    VERIFICAR(ultimasPistas(&l, 5, &ev) == 5 && ev == l.eventos + l.total - 5);
+    VERIFICAR(ultimasPistas(&l, l.total + 10, &ev) == l.total && ev == l.eventos);
+    VERIFICAR(ultimasPistas(&l, -1, &ev) == 0);
+    free(l.eventos);
+
+    // linha vazia
+    LinhaDoTempo vazia = { NULL, 0, 0 };
+    VERIFICAR(pistasEntreMovimentos(&vazia, 0, 100, &ev) == 0);
+}
+
+/* ----------------------------- Consultas ao caderno ----------------------------- */
+
+#define CONSULTA_PISTAS 400
+#define CONSULTA_FILTROS 3000
+
+static char nomesPistasConsulta[CONSULTA_PISTAS][32];
+static const char *suspeitosConsulta[] = { "Sr. Raro", "Sra. Comum", "Dr. Frequente", "Cel. Mostarda" };
+
+static int coletarSalas(Room *r, Room **salas, int n) {
+    if (!r) return n;
+    salas[n++] = r;
+    n = coletarSalas(r->left, salas, n);
+    return coletarSalas(r->right, salas, n);
+}
+
+// Resultado esperado de um filtro: varredura de todos os registros, comparando
+// o suspeito pelo nome
+static int varrerCaderno(const Caderno *c, const FiltroPistas *f, int *saida) {
+    int n = 0;
+    for (int i = 0; i < c->total; i++) {
+        const RegistroPista *r = &c->registros[i];
+        const char *s = r->suspeito >= 0 ? c->suspeitos[r->suspeito] : NULL;
+        if (f->suspeito && (!s || strcmp(s, f->suspeito) != 0)) continue;
+        if (f->sala >= 0 && r->sala != f->sala) continue;
+        if (f->andar >= 0 && r->andar != f->andar) continue;
+        if (r->movimento < f->movimentoMin) continue;
+        if (f->movimentoMax >= 0 && r->movimento > f->movimentoMax) continue;
+        saida[n++] = i;
+    }
+    return n;
+}
+
+// Filtros aleatórios conferidos com a varredura; cada plano precisa ser usado
+static void testarConsultas(uint64_t *semente) {
+    PacoteCasos *pc = carregarPacote(CASOS, N_CASOS);
+    Caso *caso = buscarCaso(pc, "mansao");
+    VERIFICAR(caso != NULL);
+    if (!caso) { liberarPacote(pc); return; }
+    Room *salas[256];
+    int nSalas = coletarSalas(entradaPropriedade(caso->propriedade), salas, 0);
+
+    Caderno *c = criarCaderno();
+    int movimento = 0;
+    for (int i = 0; i < CONSULTA_PISTAS; i++) {
+        snprintf(nomesPistasConsulta[i], sizeof(nomesPistasConsulta[i]), "pista %d", i);
+        movimento += (int)(proximoAleatorio(semente) % 3);
+        uint64_t x = proximoAleatorio(semente) % 100;   // suspeitos com frequências bem diferentes
+        const char *suspeito = x < 2 ? suspeitosConsulta[0] : x < 30 ? suspeitosConsulta[1]
+                             : x < 90 ? suspeitosConsulta[2] : NULL;
+        registrarPista(c, i, nomesPistasConsulta[i], salas[proximoAleatorio(semente) % nSalas],
+                       suspeito, movimento);
+    }
+
+    static int obtidos[CONSULTA_PISTAS], esperados[CONSULTA_PISTAS];
+    int usados[4] = {0}, erros = 0;
+    for (int k = 0; k < CONSULTA_FILTROS; k++) {
+        FiltroPistas f = { NULL, -1, 0, -1, -1 };
+        uint64_t x = proximoAleatorio(semente);
+        if (x % 2) f.suspeito = suspeitosConsulta[(x >> 1) % N_ELEMENTOS(suspeitosConsulta)];
+        if ((x >> 4) % 3 == 0) f.sala = salas[(x >> 8) % nSalas]->id;
+        if ((x >> 16) % 4 == 0) f.sala = nSalas + 5;   // sala sem registros
+        Room *r = salas[(x >> 24) % nSalas];
+        if ((x >> 20) % 3 == 0 && r->andar) f.andar = r->andar->id;
+        if ((x >> 28) % 2) {
+            f.movimentoMin = (int)((x >> 32) % (movimento + 4)) - 2;
+            f.movimentoMax = f.movimentoMin + (int)((x >> 44) % (movimento / 2 + 2)) - 1;
+        }
+        PlanoConsulta plano;
+        int n = consultarPistas(c, &f, obtidos, CONSULTA_PISTAS, &plano);
+        int m = varrerCaderno(c, &f, esperados);
+        erros += n != m || memcmp(obtidos, esperados, n * sizeof(int)) != 0;
+        usados[plano]++;
+    }
+    VERIFICAR(erros == 0);
+    VERIFICAR(usados[PLANO_VARREDURA] && usados[PLANO_SUSPEITO] && usados[PLANO_SALA] && usados[PLANO_TEMPO]);
+
+    // saída menor que o resultado: conta tudo, grava só `max`
+    FiltroPistas todos = { NULL, -1, 0, -1, -1 };
+    int poucos[4] = { -1, -1, -1, -1 };
+    VERIFICAR(consultarPistas(c, &todos, poucos, 3, NULL) == c->total);
+    VERIFICAR(poucos[0] == 0 && poucos[2] == 2 && poucos[3] == -1);
+
+    // suspeito que não está no caderno
+    FiltroPistas ausente = { "Ninguém", -1, 0, -1, -1 };
+    PlanoConsulta plano;
+    VERIFICAR(consultarPistas(c, &ausente, obtidos, CONSULTA_PISTAS, &plano) == 0);
+    liberarCaderno(c);
+    liberarPacote(pc);
+}
+
+void testarLinhaDoTempo(void) {
+    uint64_t semente = 3;
+    testarFaixas(&semente);
+    testarConsultas(&semente);
+}
@@ -0,0 +1,120 @@
+#include "testes.h"
+
+/* ----------------------------- Lista de saltos concorrente ----------------------------- */
+
+#define SALTOS_CHAVES 2000
+#define SALTOS_THREADS 8
+
+static char chavesSaltos[SALTOS_CHAVES][24];
+
+typedef struct {
+    const char *anterior;
+    unsigned visitadas;
+    int foraDeOrdem;
+} Instantaneo;
+
+static void visitarInstantaneo(const char *pista, void *ctx) {
+    Instantaneo *v = ctx;
+    if (v->anterior && strcmp(v->anterior, pista) >= 0) v->foraDeOrdem++;
+    v->anterior = pista;
+    v->visitadas++;
+}
+
+// Percorre a lista conferindo ordem e tamanho do instantâneo; retorna o tamanho
+static unsigned conferirInstantaneo(ListaSaltos *l) {
+    Instantaneo v = { NULL, 0, 0 };
+    unsigned versao = percorrerListaSaltos(l, visitarInstantaneo, &v);
+    VERIFICAR(v.foraDeOrdem == 0 && v.visitadas == versao);
+    return versao;
+}
+
+typedef struct {
+    ListaSaltos *lista;
+    atomic_int *insercoes;    // quantas threads receberam nova = 1 por chave
+    uint64_t semente;
+} TrabalhoSaltos;
+
+// Todas as threads inserem todas as chaves, cada uma em outra ordem
+static void *inserirEmParalelo(void *arg) {
+    TrabalhoSaltos *t = arg;
+    int ordem[SALTOS_CHAVES];
+    for (int i = 0; i < SALTOS_CHAVES; i++) ordem[i] = i;
+    for (int i = SALTOS_CHAVES - 1; i > 0; i--) {
+        int j = (int)(proximoAleatorio(&t->semente) % (uint64_t)(i + 1));
+        int tmp = ordem[i]; ordem[i] = ordem[j]; ordem[j] = tmp;
+    }
+    for (int i = 0; i < SALTOS_CHAVES; i++) {
+        int nova;
+        const char *chave = chavesSaltos[ordem[i]];
+        NoSaltos *no = inserirNaListaSaltos(t->lista, chave, &nova);
+        if (nova) atomic_fetch_add(&t->insercoes[ordem[i]], 1);
+        if (strcmp(no->pista, chave) != 0 || !buscarNaListaSaltos(t->lista, chave))
+            atomic_fetch_add(&t->insercoes[ordem[i]], 1000);
+    }
+    return NULL;
+}
+
+typedef struct {
+    ListaSaltos *lista;
+    atomic_int *terminou;
+    int leituras;
+} LeitorSaltos;
+
+// Instantâneos tirados enquanto as inserções acontecem só crescem
+static void *lerEmParalelo(void *arg) {
+    LeitorSaltos *r = arg;
+    unsigned anterior = 0;
+    while (!atomic_load(r->terminou)) {
+        unsigned versao = conferirInstantaneo(r->lista);
+        VERIFICAR(versao >= anterior);
+        anterior = versao;
+        r->leituras++;
+    }
+    return NULL;
+}
+
+void testarListaSaltos(void) {
+    for (int i = 0; i < SALTOS_CHAVES; i++) snprintf(chavesSaltos[i], sizeof(chavesSaltos[i]), "pista %d", i);
+
+    // uma thread: duplicatas, busca e ordem
+    ListaSaltos lista;
+    inicializarListaSaltos(&lista);
+    VERIFICAR(!buscarNaListaSaltos(&lista, "pista 0"));
+    VERIFICAR(conferirInstantaneo(&lista) == 0);
+    for (int rodada = 0; rodada < 2; rodada++)
+        for (int i = SALTOS_CHAVES - 1; i >= 0; i -= 2) {
+            int nova;
+            NoSaltos *no = inserirNaListaSaltos(&lista, chavesSaltos[i], &nova);
+            VERIFICAR(nova == (rodada == 0) && strcmp(no->pista, chavesSaltos[i]) == 0);
+        }
+    for (int i = 0; i < SALTOS_CHAVES; i++) VERIFICAR(buscarNaListaSaltos(&lista, chavesSaltos[i]) == (i % 2 == 1));
+    VERIFICAR(!buscarNaListaSaltos(&lista, "pista"));
+    VERIFICAR(!buscarNaListaSaltos(&lista, "pista 19999"));
+    VERIFICAR(conferirInstantaneo(&lista) == SALTOS_CHAVES / 2);
+    liberarListaSaltos(&lista);
+    VERIFICAR(conferirInstantaneo(&lista) == 0);
+
+    // várias threads disputando as mesmas chaves, com um leitor ao lado
+    static atomic_int insercoes[SALTOS_CHAVES];
+    for (int i = 0; i < SALTOS_CHAVES; i++) atomic_init(&insercoes[i], 0);
+    atomic_int terminou;
+    atomic_init(&terminou, 0);
+    TrabalhoSaltos trabalhos[SALTOS_THREADS];
+    pthread_t threads[SALTOS_THREADS], leitor;
+    LeitorSaltos dadosLeitor = { &lista, &terminou, 0 };
+    pthread_create(&leitor, NULL, lerEmParalelo, &dadosLeitor);
+    for (int t = 0; t < SALTOS_THREADS; t++) {
+        trabalhos[t] = (TrabalhoSaltos){ &lista, insercoes, 1000 + (uint64_t)t };
+        pthread_create(&threads[t], NULL, inserirEmParalelo, &trabalhos[t]);
+    }
+    for (int t = 0; t < SALTOS_THREADS; t++) pthread_join(threads[t], NULL);
+    atomic_store(&terminou, 1);
+    pthread_join(leitor, NULL);
+
+    int repetidas = 0;
+    for (int i = 0; i < SALTOS_CHAVES; i++) repetidas += atomic_load(&insercoes[i]) != 1;
+    VERIFICAR(repetidas == 0);
+    VERIFICAR(dadosLeitor.leituras > 0);
+    VERIFICAR(conferirInstantaneo(&lista) == SALTOS_CHAVES);
+    liberarListaSaltos(&lista);
+}
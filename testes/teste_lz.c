@@ -0,0 +1,125 @@
+#include "testes.h"
+
+/* ----------------------------- Compressão LZ ----------------------------- */
+
+#define LZ_MAIOR_ENTRADA (1 << 20)
+
+// Comprime e descomprime `n` bytes, conferindo tamanho e conteúdo
+static void idaEVolta(const uint8_t *dados, size_t n) {
+    uint8_t *comprimido = malloc(limiteLz(n));
+    uint8_t *volta = malloc(n + 1);
+    if (!comprimido || !volta) { perror("malloc"); exit(EXIT_FAILURE); }
+    size_t m = comprimirLz(dados, n, comprimido);
+    VERIFICAR(m <= limiteLz(n));
+    VERIFICAR(descomprimirLz(comprimido, m, volta, n) == (long)n);
+    VERIFICAR(memcmp(volta, dados, n) == 0);
+    // saída sem espaço suficiente ou entrada truncada nunca reproduzem os dados
+    if (n > 0) VERIFICAR(descomprimirLz(comprimido, m, volta, n - 1) < 0);
+    if (m > 1) VERIFICAR(descomprimirLz(comprimido, m - 1, volta, n) != (long)n);
+    free(comprimido);
+    free(volta);
+}
+
+// Dados comprimidos com bytes trocados: a descompressão não pode sair do buffer
+static void corromper(const uint8_t *dados, size_t n, uint64_t *semente) {
+    uint8_t *comprimido = malloc(limiteLz(n));
+    uint8_t *copia = malloc(limiteLz(n));
+    uint8_t *volta = malloc(n);
+    if (!comprimido || !copia || !volta) { perror("malloc"); exit(EXIT_FAILURE); }
+    size_t m = comprimirLz(dados, n, comprimido);
+    for (int t = 0; t < 2000; t++) {
+        memcpy(copia, comprimido, m);
+        for (int k = 0; k < 3; k++) copia[proximoAleatorio(semente) % m] = (uint8_t)proximoAleatorio(semente);
+        VERIFICAR(descomprimirLz(copia, m, volta, n) <= (long)n);
+    }
+    free(comprimido);
+    free(copia);
+    free(volta);
+}
+
+static void testarBlocos(const uint8_t *texto, size_t nTexto, const uint8_t *aleatorio, size_t nAleatorio) {
+    // em memória: texto é comprimido, bytes aleatórios ficam crus
+    uint8_t *bloco = malloc(limiteBloco((uint32_t)nAleatorio));
+    if (!bloco) { perror("malloc"); exit(EXIT_FAILURE); }
+    uint32_t n;
+    size_t tam = montarBloco(texto, (uint32_t)nTexto, bloco);
+    VERIFICAR(tam < nTexto);
+    char *aberto = abrirBlocoNaMemoria(bloco, tam, &n);
+    VERIFICAR(aberto && n == nTexto && memcmp(aberto, texto, n) == 0 && aberto[n] == '\0');
+    free(aberto);
+    VERIFICAR(abrirBlocoNaMemoria(bloco, tam - 1, &n) == NULL);
+
+    tam = montarBloco(aleatorio, (uint32_t)nAleatorio, bloco);
+    VERIFICAR(tam == nAleatorio + 8);
+    aberto = abrirBlocoNaMemoria(bloco, tam, &n);
+    VERIFICAR(aberto && n == nAleatorio && memcmp(aberto, aleatorio, n) == 0);
+    free(aberto);
+    free(bloco);
+
+    // em arquivo: vários blocos seguidos, inclusive vazio, e fim do arquivo
+    char caminho[64];
+    arquivoTemporario(caminho, sizeof(caminho));
+    FILE *f = fopen(caminho, "w+b");
+    VERIFICAR(f != NULL);
+    if (!f) return;
+    VERIFICAR(gravarBloco(f, texto, (uint32_t)nTexto) == 0);
+    VERIFICAR(gravarBloco(f, "", 0) == 0);
+    VERIFICAR(gravarBloco(f, aleatorio, (uint32_t)nAleatorio) == 0);
+    rewind(f);
+    void *lido = lerBloco(f, &n);
+    VERIFICAR(lido && n == nTexto && memcmp(lido, texto, n) == 0);
+    free(lido);
+    lido = lerBloco(f, &n);
+    VERIFICAR(lido && n == 0);
+    free(lido);
+    lido = lerBloco(f, &n);
+    VERIFICAR(lido && n == nAleatorio && memcmp(lido, aleatorio, n) == 0);
+    free(lido);
+    VERIFICAR(lerBloco(f, &n) == NULL);
+    fclose(f);
+    remove(caminho);
+}
+
+void testarLz(void) {
+    uint64_t semente = 42;
+    uint8_t *texto = malloc(LZ_MAIOR_ENTRADA), *aleatorio = malloc(LZ_MAIOR_ENTRADA);
+    uint8_t *repetido = malloc(LZ_MAIOR_ENTRADA);
+    if (!texto || !aleatorio || !repetido) { perror("malloc"); exit(EXIT_FAILURE); }
+
+    // comandos no formato do diário, bytes aleatórios e um único byte repetido
+    static const char *comandos[] = { "e\n", "d\n", "c\n", "m\n", "v\n", "p\n", "Sr. Verde\n" };
+    size_t n = 0;
+    while (n < LZ_MAIOR_ENTRADA) {
+        const char *c = comandos[proximoAleatorio(&semente) % N_ELEMENTOS(comandos)];
+        for (; *c && n < LZ_MAIOR_ENTRADA; c++) texto[n++] = (uint8_t)*c;
+    }
+    for (size_t i = 0; i < LZ_MAIOR_ENTRADA; i++) aleatorio[i] = (uint8_t)proximoAleatorio(&semente);
+    memset(repetido, 'x', LZ_MAIOR_ENTRADA);
+
+    // tamanhos em torno dos limites de literais finais e das cópias em blocos de 8/16
+    static const size_t tamanhos[] = { 0, 1, 4, 7, 8, 9, 12, 15, 16, 17, 31, 32, 33, 255, 256, 270,
+                                       4096, 65535, 65536, 65537, LZ_MAIOR_ENTRADA };
+    for (int i = 0; i < N_ELEMENTOS(tamanhos); i++) {
+        idaEVolta(texto, tamanhos[i]);
+        idaEVolta(aleatorio, tamanhos[i]);
+        idaEVolta(repetido, tamanhos[i]);
+    }
+    // casamentos sobrepostos com deslocamentos curtos (1 a 20 bytes)
+    for (int periodo = 1; periodo <= 20; periodo++) {
+        uint8_t padrao[4096];
+        for (int i = 0; i < (int)sizeof(padrao); i++) padrao[i] = (uint8_t)('a' + i % periodo);
+        idaEVolta(padrao, sizeof(padrao));
+    }
+    // repetido comprime bem
+    uint8_t *comprimido = malloc(limiteLz(LZ_MAIOR_ENTRADA));
+    if (!comprimido) { perror("malloc"); exit(EXIT_FAILURE); }
+    VERIFICAR(comprimirLz(repetido, LZ_MAIOR_ENTRADA, comprimido) < LZ_MAIOR_ENTRADA / 100);
+    free(comprimido);
+
+    corromper(texto, 4096, &semente);
+    testarBlocos(texto, 8192, aleatorio, 8192);
+
+    free(texto);
+    free(aleatorio);
+    free(repetido);
+}
@@ -0,0 +1,85 @@
+#include "testes.h"
+
+/* ----------------------------- Placar de suspeitos ----------------------------- */
+
+#define PLACAR_TESTE_SUSPEITOS 60
+#define PLACAR_TESTE_AJUSTES 5000
+
+static const int *pontosReferencia;
+
+// Mesma ordem do placar: mais pontos primeiro, empate pelo menor id
+static int compararSuspeitos(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    if (pontosReferencia[x] != pontosReferencia[y]) return pontosReferencia[x] > pontosReferencia[y] ? -1 : 1;
+    return (x > y) - (x < y);
+}
+
+// Compara o placar com a ordenação por força bruta dos pontos
+static void conferirPlacar(const PlacarSuspeitos *p, const int *pontos, int n) {
+    int esperado[PLACAR_TESTE_SUSPEITOS];
+    for (int i = 0; i < n; i++) esperado[i] = i;
+    pontosReferencia = pontos;
+    qsort(esperado, n, sizeof(int), compararSuspeitos);
+    VERIFICAR(p->total == n);
+    VERIFICAR(liderDoPlacar(p) == (n > 0 ? esperado[0] : -1));
+
+    int primeiros[PLACAR_TESTE_SUSPEITOS + 1];
+    int k = primeirosDoPlacar(p, primeiros, PLACAR_TESTE_SUSPEITOS + 1);
+    VERIFICAR(k == n);
+    int divergentes = 0;
+    for (int i = 0; i < k && i < n; i++) divergentes += primeiros[i] != esperado[i];
+    VERIFICAR(divergentes == 0);
+
+    // top-k menores que o placar são prefixos da ordem completa
+    for (int top = 1; top <= 5; top++) {
+        int m = primeirosDoPlacar(p, primeiros, top);
+        VERIFICAR(m == (n < top ? n : top) && memcmp(primeiros, esperado, m * sizeof(int)) == 0);
+    }
+
+    // cada suspeito na posição indicada, com os pontos da referência
+    int posicoes = 0;
+    for (int s = 0; s < n; s++)
+        posicoes += p->pontos[s] != pontos[s] || p->posicao[s] < 0 || p->posicao[s] >= n ||
+                    p->heap[p->posicao[s]] != s;
+    VERIFICAR(posicoes == 0);
+}
+
+void testarPlacar(void) {
+    uint64_t semente = 11;
+    PlacarSuspeitos p;
+    memset(&p, 0, sizeof(p));
+    int pontos[PLACAR_TESTE_SUSPEITOS] = {0}, n = 0;
+    conferirPlacar(&p, pontos, 0);
+    VERIFICAR(primeirosDoPlacar(&p, pontos, 3) == 0);
+
+    for (int i = 0; i < PLACAR_TESTE_AJUSTES; i++) {
+        // novos suspeitos entram com id sequencial; pontos em faixa curta para produzir empates
+        int s;
+        if (n == 0 || (n < PLACAR_TESTE_SUSPEITOS && proximoAleatorio(&semente) % 20 == 0)) s = n++;
+        else s = (int)(proximoAleatorio(&semente) % n);
+        int delta = (int)(proximoAleatorio(&semente) % 5) - 2;
+        ajustarPlacar(&p, s, delta);
+        pontos[s] += delta;
+        if (i % 97 == 0) conferirPlacar(&p, pontos, n);
+    }
+    conferirPlacar(&p, pontos, n);
+
+    // ids fora da sequência são ignorados
+    ajustarPlacar(&p, -1, 5);
+    ajustarPlacar(&p, n + 1, 5);
+    conferirPlacar(&p, pontos, n);
+
+    // o clone evolui separado do original
+    PlacarSuspeitos copia = clonarPlacar(&p);
+    int pontosCopia[PLACAR_TESTE_SUSPEITOS];
+    memcpy(pontosCopia, pontos, sizeof(pontos));
+    for (int i = 0; i < 200; i++) {
+        int s = (int)(proximoAleatorio(&semente) % n);
+        ajustarPlacar(&copia, s, 3);
+        pontosCopia[s] += 3;
+    }
+    conferirPlacar(&copia, pontosCopia, n);
+    conferirPlacar(&p, pontos, n);
+    liberarPlacar(&copia);
+    liberarPlacar(&p);
+}
@@ -0,0 +1,72 @@
+#include "testes.h"
+
+/* ----------------------------- Procedência das pistas ----------------------------- */
+
+// As duas direções do índice conferidas com as associações da definição
+static void conferirProcedencia(const IndiceProcedencia *idx, Room *mansao,
+                                const PistaDeSala *defs, int nDefs) {
+    int associacoes = 0;
+    for (int i = 0; i < nDefs; i++) {
+        int p = idPista(idx, defs[i].pista);
+        VERIFICAR(p >= 0 && p < idx->nPistas && strcmp(idx->pistas[p], defs[i].pista) == 0);
+        // salas esperadas: as da definição, na mesma ordem, ignorando as inexistentes
+        int esperadas[64], nEsperadas = 0;
+        for (int k = 0; k < nDefs; k++) {
+            Room *r = strcmp(defs[k].pista, defs[i].pista) == 0 ? buscarSala(mansao, defs[k].sala) : NULL;
+            if (r && nEsperadas < 64) esperadas[nEsperadas++] = r->id;
+        }
+        int n;
+        const int *salas = salasDaPista(idx, p, &n);
+        VERIFICAR(n == nEsperadas && (n == 0 || memcmp(salas, esperadas, n * sizeof(int)) == 0));
+        if (buscarSala(mansao, defs[i].sala)) associacoes++;
+    }
+
+    // cada par sala -> pista aparece também como pista -> sala
+    int total = 0;
+    for (int s = 0; s < idx->nSalas; s++) {
+        int n;
+        const int *pistas = pistasDaSala(idx, s, &n);
+        total += n;
+        for (int i = 0; i < n; i++) {
+            int m, achou = 0;
+            const int *salas = salasDaPista(idx, pistas[i], &m);
+            for (int k = 0; k < m; k++) achou |= salas[k] == s;
+            VERIFICAR(achou);
+        }
+    }
+    VERIFICAR(total == associacoes);
+
+    int n;
+    VERIFICAR(idPista(idx, "Pista que não existe") == -1 && idPista(idx, NULL) == -1);
+    VERIFICAR(salasDaPista(idx, -1, &n) == NULL && n == 0);
+    VERIFICAR(salasDaPista(idx, idx->nPistas, &n) == NULL && n == 0);
+}
+
+void testarProcedencia(void) {
+    PacoteCasos *pc = carregarPacote(CASOS, N_CASOS);
+    for (int i = 0; i < pc->nCasos; i++) {
+        Caso *c = &pc->casos[i];
+        conferirProcedencia(&c->procedencia, entradaPropriedade(c->propriedade), c->def->pistas, c->def->nPistas);
+    }
+
+    // pista em várias salas, sala com várias pistas e sala inexistente
+    static const PistaDeSala defs[] = {
+        { "Cozinha",    "Faca sumida" },
+        { "Entrada",    "Faca sumida" },
+        { "Porão",      "Faca sumida" },
+        { "Cozinha",    "Avental manchado" },
+        { "Torre",      "Avental manchado" },
+        { "Sala nenhuma", "Bilhete perdido" },
+    };
+    Caso *mansao = buscarCaso(pc, "mansao");
+    VERIFICAR(mansao != NULL);
+    if (mansao) {
+        IndiceProcedencia idx;
+        Room *entrada = entradaPropriedade(mansao->propriedade);
+        construirProcedencia(&idx, entrada, defs, N_ELEMENTOS(defs), &pc->dic);
+        VERIFICAR(idx.nPistas == 3);
+        conferirProcedencia(&idx, entrada, defs, N_ELEMENTOS(defs));
+        freeProcedencia(&idx);
+    }
+    liberarPacote(pc);
+}
@@ -0,0 +1,148 @@
+#include "testes.h"
+
+/* ----------------------------- Ranking global de jogadores ----------------------------- */
+
+#define RANKING_TESTE_JOGADORES 300
+#define RANKING_TESTE_THREADS 6
+
+typedef struct {
+    uint64_t chave;
+    uint32_t jogador;
+} EntradaEsperada;
+
+static int compararEntradas(const void *a, const void *b) {
+    const EntradaEsperada *x = a, *y = b;
+    if (x->chave != y->chave) return x->chave < y->chave ? -1 : 1;
+    return (x->jogador > y->jogador) - (x->jogador < y->jogador);
+}
+
+// Compara consultas do ranking com a ordenação por força bruta das chaves
+static void conferirRanking(RankingGlobal *r, const uint64_t *chaves, int n) {
+    EntradaEsperada esperado[RANKING_TESTE_JOGADORES];
+    int total = 0;
+    for (int j = 0; j < n; j++)
+        if (chaves[j] != RANKING_AUSENTE) esperado[total++] = (EntradaEsperada){ chaves[j], (uint32_t)j };
+    qsort(esperado, total, sizeof(EntradaEsperada), compararEntradas);
+    VERIFICAR(totalDoRanking(r) == total);
+
+    ItemRanking itens[RANKING_TESTE_JOGADORES + 1];
+    int k = primeirosDoRanking(r, itens, RANKING_TESTE_JOGADORES + 1);
+    VERIFICAR(k == total);
+    int divergentes = 0;
+    for (int i = 0; i < k && i < total; i++)
+        divergentes += itens[i].jogador != esperado[i].jogador ||
+                       chaveRanking(itens[i].tempoMs, itens[i].eficiencia) != esperado[i].chave;
+    VERIFICAR(divergentes == 0);
+    VERIFICAR(primeirosDoRanking(r, itens, 3) == (total < 3 ? total : 3));
+
+    int posicoes = 0;
+    for (int i = 0; i < total; i++) posicoes += posicaoNoRanking(r, (int)esperado[i].jogador) != i + 1;
+    for (int j = 0; j < n; j++) posicoes += chaves[j] == RANKING_AUSENTE && posicaoNoRanking(r, j) != 0;
+    VERIFICAR(posicoes == 0);
+}
+
+// Tempos e eficiências em faixas curtas para produzir empates
+static void sortearResultado(uint64_t *semente, uint32_t *tempo, uint32_t *eficiencia) {
+    *tempo = 1000 + (uint32_t)(proximoAleatorio(semente) % 40) * 500;
+    *eficiencia = (uint32_t)(proximoAleatorio(semente) % 5) * 250;
+}
+
+typedef struct {
+    RankingGlobal *ranking;
+    uint64_t *chaves;         // última chave gravada por jogador desta thread
+    int primeiro;             // a thread cuida dos jogadores primeiro, primeiro + THREADS, ...
+    uint64_t semente;
+} TrabalhoRanking;
+
+static void *atualizarEmParalelo(void *arg) {
+    TrabalhoRanking *t = arg;
+    for (int i = 0; i < 4000; i++) {
+        int j = t->primeiro + RANKING_TESTE_THREADS *
+                (int)(proximoAleatorio(&t->semente) % (RANKING_TESTE_JOGADORES / RANKING_TESTE_THREADS));
+        uint32_t tempo, eficiencia;
+        sortearResultado(&t->semente, &tempo, &eficiencia);
+        atualizarRanking(t->ranking, j, tempo, eficiencia);
+        t->chaves[j] = chaveRanking(tempo, eficiencia);
+    }
+    return NULL;
+}
+
+typedef struct {
+    RankingGlobal *ranking;
+    atomic_int *terminou;
+    int foraDeOrdem, leituras;
+} LeitorRanking;
+
+// Consultas concorrentes sempre veem a lista ordenada
+static void *consultarEmParalelo(void *arg) {
+    LeitorRanking *l = arg;
+    ItemRanking itens[RANKING_TESTE_JOGADORES];
+    while (!atomic_load(l->terminou)) {
+        int k = primeirosDoRanking(l->ranking, itens, RANKING_TESTE_JOGADORES);
+        for (int i = 1; i < k; i++) {
+            uint64_t a = chaveRanking(itens[i - 1].tempoMs, itens[i - 1].eficiencia);
+            uint64_t b = chaveRanking(itens[i].tempoMs, itens[i].eficiencia);
+            l->foraDeOrdem += a > b || (a == b && itens[i - 1].jogador >= itens[i].jogador);
+        }
+        posicaoNoRanking(l->ranking, 0);
+        l->leituras++;
+    }
+    return NULL;
+}
+
+void testarRanking(void) {
+    // menor tempo primeiro; no empate, maior eficiência
+    VERIFICAR(chaveRanking(1000, 0) < chaveRanking(2000, 999));
+    VERIFICAR(chaveRanking(1000, 500) < chaveRanking(1000, 250));
+    VERIFICAR(chaveRanking(UINT32_MAX, 0) != RANKING_AUSENTE);
+
+    // cadastro de nomes
+    RankingGlobal *pequeno = criarRanking(2);
+    VERIFICAR(jogadorDoRanking(pequeno, "Ana") == 0);
+    VERIFICAR(jogadorDoRanking(pequeno, "Bia") == 1);
+    VERIFICAR(jogadorDoRanking(pequeno, "Ana") == 0);
+    VERIFICAR(jogadorDoRanking(pequeno, "Caio") == -1);
+    VERIFICAR(totalDoRanking(pequeno) == 0 && posicaoNoRanking(pequeno, 0) == 0);
+    atualizarRanking(pequeno, 5, 1000, 0);   // fora da faixa: ignorado
+    VERIFICAR(totalDoRanking(pequeno) == 0);
+    liberarRanking(pequeno);
+
+    // uma thread: cada atualização confere com a força bruta de tempos em tempos
+    uint64_t semente = 5;
+    uint64_t chaves[RANKING_TESTE_JOGADORES];
+    RankingGlobal *r = criarRanking(RANKING_TESTE_JOGADORES);
+    for (int j = 0; j < RANKING_TESTE_JOGADORES; j++) {
+        char nome[32];
+        snprintf(nome, sizeof(nome), "detetive %d", j);
+        VERIFICAR(jogadorDoRanking(r, nome) == j);
+        chaves[j] = RANKING_AUSENTE;
+    }
+    conferirRanking(r, chaves, RANKING_TESTE_JOGADORES);
+    for (int i = 0; i < 3000; i++) {
+        int j = (int)(proximoAleatorio(&semente) % RANKING_TESTE_JOGADORES);
+        uint32_t tempo, eficiencia;
+        sortearResultado(&semente, &tempo, &eficiencia);
+        atualizarRanking(r, j, tempo, eficiencia);
+        chaves[j] = chaveRanking(tempo, eficiencia);
+        if (i % 100 == 0) conferirRanking(r, chaves, RANKING_TESTE_JOGADORES);
+    }
+    conferirRanking(r, chaves, RANKING_TESTE_JOGADORES);
+
+    // várias threads, cada uma com seus jogadores, e um leitor ao lado
+    atomic_int terminou;
+    atomic_init(&terminou, 0);
+    LeitorRanking leitor = { r, &terminou, 0, 0 };
+    pthread_t threadLeitor, threads[RANKING_TESTE_THREADS];
+    TrabalhoRanking trabalhos[RANKING_TESTE_THREADS];
+    pthread_create(&threadLeitor, NULL, consultarEmParalelo, &leitor);
+    for (int t = 0; t < RANKING_TESTE_THREADS; t++) {
+        trabalhos[t] = (TrabalhoRanking){ r, chaves, t, 100 + (uint64_t)t };
+        pthread_create(&threads[t], NULL, atualizarEmParalelo, &trabalhos[t]);
+    }
+    for (int t = 0; t < RANKING_TESTE_THREADS; t++) pthread_join(threads[t], NULL);
+    atomic_store(&terminou, 1);
+    pthread_join(threadLeitor, NULL);
+    VERIFICAR(leitor.leituras > 0 && leitor.foraDeOrdem == 0);
+    conferirRanking(r, chaves, RANKING_TESTE_JOGADORES);
+    liberarRanking(r);
+}
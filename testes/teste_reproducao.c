@@ -0,0 +1,66 @@
+#include "testes.h"
+
+/* ----------------------------- Reprodução de diários ----------------------------- */
+
+static const char *DIARIOS[] = {
+    DIR_DADOS_TESTES "/mansao.dq",    // com ponto de retorno (m/v) e consultas
+    DIR_DADOS_TESTES "/heranca.dq",
+    DIR_DADOS_TESTES "/farol.dq",     // outra planta
+};
+
+// Copia um diário trocando o número de movimentos da linha "#fim"
+static void adulterarDiario(const char *origem, const char *destino) {
+    FILE *in = fopen(origem, "rb"), *out = fopen(destino, "wb");
+    char magico[4];
+    VERIFICAR(in && out && fread(magico, 4, 1, in) == 1);
+    if (!in || !out) { if (in) fclose(in); if (out) fclose(out); return; }
+    fwrite(magico, 4, 1, out);
+    uint32_t tam;
+    char *bloco;
+    int trocado = 0;
+    while ((bloco = lerBloco(in, &tam))) {
+        char *fim = strstr(bloco, DIARIO_FIM);
+        if (fim) {
+            fim[strlen(DIARIO_FIM)] = fim[strlen(DIARIO_FIM)] == '9' ? '8' : '9';
+            trocado = 1;
+        }
+        gravarBloco(out, bloco, tam);
+        free(bloco);
+    }
+    VERIFICAR(trocado);
+    fclose(in);
+    fclose(out);
+}
+
+void testarReproducao(void) {
+    PacoteCasos *pc = carregarPacote(CASOS, N_CASOS);
+
+    // diários gravados pelo jogo conferem com o estado final registrado
+    for (int i = 0; i < N_ELEMENTOS(DIARIOS); i++) {
+        ResultadoReproducao res;
+        reproduzirDiario(pc, DIARIOS[i], &res);
+        if (res.estado != REPRODUCAO_OK) fprintf(stderr, "%s: %s\n", DIARIOS[i], res.detalhe);
+        VERIFICAR(res.estado == REPRODUCAO_OK);
+        VERIFICAR(res.eventos > 0);
+    }
+
+    // os mesmos diários em paralelo
+    VERIFICAR(executarReproducoes(pc, DIARIOS, N_ELEMENTOS(DIARIOS)) == 0);
+
+    // estado final adulterado é apontado como divergência
+    char caminho[64];
+    arquivoTemporario(caminho, sizeof(caminho));
+    adulterarDiario(DIARIOS[0], caminho);
+    ResultadoReproducao res;
+    reproduzirDiario(pc, caminho, &res);
+    VERIFICAR(res.estado == REPRODUCAO_DIVERGENTE);
+
+    // arquivo que não é diário
+    FILE *f = fopen(caminho, "wb");
+    if (f) { fputs("texto qualquer\n", f); fclose(f); }
+    reproduzirDiario(pc, caminho, &res);
+    VERIFICAR(res.estado == REPRODUCAO_ERRO);
+    remove(caminho);
+
+    liberarPacote(pc);
+}
@@ -0,0 +1,61 @@
+#include "testes.h"
+
+/* ----------------------------- Tabela hash de pistas ----------------------------- */
+
+#define TABELA_CHAVES 3000
+
+static char chavesTabela[TABELA_CHAVES][32];
+
+static int cadeiasOrdenadas(const TabelaPistas *t) {
+    for (int i = 0; i < HASH_SIZE; i++)
+        for (const HashEntry *e = t->baldes[i]; e && e->next; e = e->next)
+            if (strcmp(e->key, e->next->key) >= 0) return 0;
+    return 1;
+}
+
+// Metade das chaves inserida, a outra metade consultada sem sucesso; a
+// organização padrão muda no meio das inserções e não afeta a tabela
+static void testarOrganizacao(int organizacao) {
+    TabelaPistas tabela;
+    tabelaPistasPadrao = organizacao;
+    inicializarTabelaPistas(&tabela, tabelaPistasPadrao);
+    for (int i = 0; i < TABELA_CHAVES; i += 2) {
+        if (i == TABELA_CHAVES / 2) tabelaPistasPadrao = !organizacao;
+        inserirNaHash(&tabela, chavesTabela[i], chavesTabela[i + 1]);
+    }
+    VERIFICAR(tabela.organizacao == organizacao);
+    inserirNaHash(&tabela, chavesTabela[0], chavesTabela[0]);   // substitui
+    int erros = 0;
+    for (int i = 0; i < TABELA_CHAVES; i++) {
+        const char *s = encontrarSuspeito(&tabela, chavesTabela[i]);
+        const char *esperado = i == 0 ? chavesTabela[0] : i % 2 == 0 ? chavesTabela[i + 1] : NULL;
+        erros += s != esperado;
+    }
+    VERIFICAR(erros == 0);
+    VERIFICAR(!encontrarSuspeito(&tabela, NULL) && !encontrarSuspeito(&tabela, ""));
+    if (organizacao == TABELA_ORDENADA) VERIFICAR(cadeiasOrdenadas(&tabela));
+    freeHash(&tabela);
+}
+
+void testarTabela(void) {
+    int padrao = tabelaPistasPadrao;
+    for (int i = 0; i < TABELA_CHAVES; i++) snprintf(chavesTabela[i], sizeof(chavesTabela[i]), "pista %d", i);
+    testarOrganizacao(TABELA_ENCADEADA);
+    testarOrganizacao(TABELA_ORDENADA);
+
+    // tabelas dos casos montadas numa organização e consultadas depois da troca
+    for (int organizacao = TABELA_ENCADEADA; organizacao <= TABELA_ORDENADA; organizacao++) {
+        tabelaPistasPadrao = organizacao;
+        PacoteCasos *pc = carregarPacote(CASOS, N_CASOS);
+        tabelaPistasPadrao = !organizacao;
+        for (int k = 0; k < pc->nCasos; k++) {
+            const DefCaso *def = pc->casos[k].def;
+            for (int i = 0; i < def->nSuspeitos; i++) {
+                const char *s = encontrarSuspeito(&pc->casos[k].tabela, def->suspeitos[i].pista);
+                VERIFICAR(s && strcmp(s, def->suspeitos[i].suspeito) == 0);
+            }
+        }
+        liberarPacote(pc);
+    }
+    tabelaPistasPadrao = padrao;
+}
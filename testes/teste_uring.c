@@ -0,0 +1,46 @@
+#include "testes.h"
+
+/* ----------------------------- E/S assíncrona (io_uring) ----------------------------- */
+
+#define URING_TESTE_BLOCOS 40
+#define URING_TESTE_TAM 512
+
+// Escreve blocos numerados; com `falharDe` >= 0, io_uring_enter falha (fd
+// inválido) a partir desse bloco e as escritas pendentes vão por write(2)
+static void escreverBlocos(int falharDe) {
+    AnelUring *a = criarAnelUring(URING_TESTE_TAM);
+    if (!a) return;   // io_uring indisponível neste kernel
+    char caminho[64];
+    arquivoTemporario(caminho, sizeof(caminho));
+    int fd = open(caminho, O_WRONLY);
+    VERIFICAR(fd >= 0);
+    int fdAnel = a->fd;
+    for (int b = 0; b < URING_TESTE_BLOCOS; b++) {
+        if (b == falharDe) a->fd = -1;
+        int i = bufferLivreUring(a);
+        memset(a->buffers[i], 'a' + b % 26, URING_TESTE_TAM);
+        enviarUring(a, i, fd, URING_TESTE_TAM, (off_t)b * URING_TESTE_TAM);
+    }
+    drenarUring(a);
+    VERIFICAR(a->emVoo == 0 && a->naoSubmetidas == 0);
+    a->fd = fdAnel;
+    liberarAnelUring(a);
+    close(fd);
+
+    FILE *f = fopen(caminho, "rb");
+    char bloco[URING_TESTE_TAM];
+    int errados = 0;
+    for (int b = 0; b < URING_TESTE_BLOCOS; b++) {
+        if (!f || fread(bloco, URING_TESTE_TAM, 1, f) != 1) { errados++; continue; }
+        for (int k = 0; k < URING_TESTE_TAM; k++) errados += bloco[k] != 'a' + b % 26;
+    }
+    VERIFICAR(errados == 0);
+    if (f) fclose(f);
+    remove(caminho);
+}
+
+void testarUring(void) {
+    escreverBlocos(-1);
+    escreverBlocos(URING_LOTE / 2);   // falha com um lote incompleto pendente
+    escreverBlocos(URING_LOTE * 2);   // falha depois de lotes já submetidos
+}
@@ -0,0 +1,53 @@
+/*
+ Detective Quest - executor dos testes
+
+ Roda todos os testes registrados em TESTES (ou apenas os nomeados na linha de
+ comando) e sai com código 1 se algum falhar.
+*/
+
+#include "testes.h"
+
+int falhasTeste = 0;
+
+// Cria um arquivo vazio em /tmp e grava o caminho em `caminho`
+void arquivoTemporario(char *caminho, size_t tam) {
+    snprintf(caminho, tam, "/tmp/detective-teste-XXXXXX");
+    int fd = mkstemp(caminho);
+    if (fd < 0) { perror("mkstemp"); exit(EXIT_FAILURE); }
+    close(fd);
+}
+
+static const struct {
+    const char *nome;
+    void (*funcao)(void);
+} TESTES[] = {
+    { "reproducao", testarReproducao },
+    { "lz",         testarLz },
+    { "autosave",   testarAutosave },
+    { "art",        testarArt },
+    { "saltos",     testarListaSaltos },
+    { "ranking",    testarRanking },
+    { "cenario",    testarCenario },
+    { "tabela",     testarTabela },
+    { "uring",      testarUring },
+    { "procedencia", testarProcedencia },
+    { "linha_tempo", testarLinhaDoTempo },
+    { "placar",     testarPlacar },
+};
+
+int main(int argc, char **argv) {
+    int executados = 0, reprovados = 0;
+    for (int t = 0; t < N_ELEMENTOS(TESTES); t++) {
+        int escolhido = argc < 2;
+        for (int i = 1; i < argc; i++)
+            if (strcmp(argv[i], TESTES[t].nome) == 0) escolhido = 1;
+        if (!escolhido) continue;
+        int antes = falhasTeste;
+        TESTES[t].funcao();
+        executados++;
+        if (falhasTeste > antes) reprovados++;
+        printf("%-20s %s\n", TESTES[t].nome, falhasTeste > antes ? "FALHOU" : "ok");
+    }
+    printf("%d teste(s), %d com falha(s)\n", executados, reprovados);
+    return reprovados > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/*
+ Detective Quest - testes
+
+ Cada arquivo teste_*.c exporta uma função testar*() registrada em testes.c.
+ Compilar e rodar a partir da raiz do repositório:
+   gcc -std=c11 -O2 testes/[a-z]*.c src/[a-z]*.c -o testes/executar -pthread
+   ./testes/executar [nome...]
+*/
+
+#ifndef TESTES_H
+#define TESTES_H
+
+#include "../src/detective.h"
+
+// Diretório dos arquivos usados pelos testes (diários gravados etc.)
+#define DIR_DADOS_TESTES "testes/diarios"
+
+extern int falhasTeste;
+
+// Registra uma falha sem interromper o teste
+#define VERIFICAR(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            falhasTeste++; \
+        } \
+    } while (0)
+
+void arquivoTemporario(char *caminho, size_t tam);
+
+/* ----------------------------- teste_reproducao.c ----------------------------- */
+
+void testarReproducao(void);
+
+/* ----------------------------- teste_lz.c ----------------------------- */
+
+void testarLz(void);
+
+/* ----------------------------- teste_autosave.c ----------------------------- */
+
+void testarAutosave(void);
+
+/* ----------------------------- teste_art.c ----------------------------- */
+
+void testarArt(void);
+
+/* ----------------------------- teste_lista_saltos.c ----------------------------- */
+
+void testarListaSaltos(void);
+
+/* ----------------------------- teste_ranking.c ----------------------------- */
+
+void testarRanking(void);
+
+/* ----------------------------- teste_cenario.c ----------------------------- */
+
+void testarCenario(void);
+
+/* ----------------------------- teste_tabela.c ----------------------------- */
+
+void testarTabela(void);
+
+/* ----------------------------- teste_uring.c ----------------------------- */
+
+void testarUring(void);
+
+/* ----------------------------- teste_procedencia.c ----------------------------- */
+
+void testarProcedencia(void);
+
+/* ----------------------------- teste_linha_tempo.c ----------------------------- */
+
+void testarLinhaDoTempo(void);
+
+/* ----------------------------- teste_placar.c ----------------------------- */
+
+void testarPlacar(void);
+
+#endif
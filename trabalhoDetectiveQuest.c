@@ -3,364 +3,203 @@
  Implementação em C conforme requisitos.
 
  Estruturas:
- - Árvore binária de cômodos (Room)
- - Árvore binária de busca (BST) para pistas (ClueNode)
+ - Árvore binária de cômodos (Room), organizada em propriedade -> prédios -> andares
+ - Árvore binária de busca (BST) para pistas (ClueNode), ou árvore radix
+   adaptativa (ART) com compressão de caminho (--caderno art)
  - Tabela hash simples para mapear pista -> suspeito
-
- Funções documentadas conforme solicitado.
+ - Salas e entradas da hash alocadas em pools de lajes com lista livre
+ - Caderno com índices por suspeito, sala e tempo; índice de procedência sala <-> pista
+ - Placar ao vivo dos suspeitos em heap binário indexado (comando p)
+ - Ranking de jogadores por tempo de solução e eficiência em lista de saltos sem
+   travas com remoção (--ranking <arquivo>)
+ - Transmissão da sessão para espectadores (--espectador <arquivo|fifo>)
+ - Sessões bifurcáveis com caderno compartilhado por cópia na escrita
+ - Modo cooperativo em lockstep para 2 a 8 detetives (--coop <n>), com coletas
+   paralelas em um caderno de equipe sobre lista de saltos concorrente
+ - Relatório de memória por estrutura, incluindo overhead do alocador
+ - Compressor LZ próprio aplicado por bloco ao diário de comandos (--diario <arquivo>),
+   gravado com io_uring e buffers registrados quando o kernel permitir;
+   diários conferidos em paralelo por reprodução (--reproduzir <diário>...)
+   e aos jogos salvos (comando g, --carregar <arquivo>)
+ - Salvamento automático incremental: checkpoints completos + deltas (--autosave <arquivo>)
+ - Descrições longas das salas comprimidas em blocos por caso, descomprimidas na
+   primeira visita para um cache limitado; uma thread antecipa as salas vizinhas
+   e o caminho mais percorrido enquanto o jogador decide (--sem-prefetch desativa)
+ - Suíte de benchmarks (--bench <arquivo>); compare execuções com comparar_bench.c
+ - Registro de backends (índice do caderno, tabela de pistas, alocação dos nós)
+   escolhidos pelo nome (--backend <família>=<nome>, --backends lista); a suíte
+   de benchmarks mede cada um na mesma carga
+ - Entrada lida em blocos grandes, com busca vetorizada de quebras de linha
+ - Perfilador por amostragem com SIGPROF, gravando pilhas dobradas para
+   flame graphs (--perfil <arquivo>)
+ - Métricas no formato do Prometheus (contadores por CPU, histograma de latência
+   dos comandos, memória por estrutura) servidas em socket Unix (--metricas <socket>)
+
+ Funções documentadas conforme solicitado. Este arquivo contém apenas main();
+ cada subsistema fica em src/ (um .c por seção, declarações em src/detective.h).
+ Compilar: gcc -std=c11 -O2 trabalhoDetectiveQuest.c src/[a-z]*.c -o detective -pthread
+ (com --perfil, acrescente -rdynamic para que as pilhas tenham nomes de funções)
 */
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
-
-#define HASH_SIZE 101
-#define MAX_INPUT 256
-
-/* ----------------------------- Estruturas ----------------------------- */
-
-// Nó da árvore de cômodos
-typedef struct Room {
-    char *name;
-    struct Room *left;
-    struct Room *right;
-} Room;
-
-// Nó da BST de pistas
-typedef struct ClueNode {
-    char *clue;
-    struct ClueNode *left;
-    struct ClueNode *right;
-} ClueNode;
-
-// Entrada da tabela hash (cadeia simples)
-typedef struct HashEntry {
-    char *key;       // pista
-    char *suspect;   // suspeito associado
-    struct HashEntry *next;
-} HashEntry;
-
-/* ----------------------------- Auxiliares ----------------------------- */
-
-// Duplicador seguro de string
-char *strdup_safe(const char *s) {
-    if (!s) return NULL;
-    char *dup = malloc(strlen(s) + 1);
-    if (!dup) { perror("malloc"); exit(EXIT_FAILURE); }
-    strcpy(dup, s);
-    return dup;
-}
-
-// Trim newline de fgets
-void trim_newline(char *s) {
-    if (!s) return;
-    size_t L = strlen(s);
-    if (L>0 && s[L-1]=='\n') s[L-1] = '\0';
-}
-
-// Lowercase a string (modifica in-place)
-void str_tolower_inplace(char *s) {
-    for (; *s; ++s) *s = (char)tolower((unsigned char)*s);
-}
-
-/* ----------------------------- Funções Requeridas ----------------------------- */
-
-/**
- * criarSala()
- * Cria dinamicamente um cômodo com o nome fornecido.
- * Retorna um ponteiro para Room alocado.
- */
-Room *criarSala(const char *name) {
-    Room *r = (Room*)malloc(sizeof(Room));
-    if (!r) { perror("malloc"); exit(EXIT_FAILURE); }
-    r->name = strdup_safe(name);
-    r->left = r->right = NULL;
-    return r;
-}
-
-/**
- * inserirPista()
- * Insere uma pista na árvore BST de pistas em ordem lexicográfica.
- * Evita inserção duplicada (se já existe, não insere).
- * Retorna o nó raiz (possivelmente atualizado).
- */
-ClueNode *inserirPista(ClueNode *root, const char *clue) {
-    if (!clue) return root;
-    if (!root) {
-        ClueNode *n = (ClueNode*)malloc(sizeof(ClueNode));
-        if (!n) { perror("malloc"); exit(EXIT_FAILURE); }
-        n->clue = strdup_safe(clue);
-        n->left = n->right = NULL;
-        return n;
-    }
-    int cmp = strcmp(clue, root->clue);
-    if (cmp == 0) return root; // já existe
-    if (cmp < 0) root->left = inserirPista(root->left, clue);
-    else root->right = inserirPista(root->right, clue);
-    return root;
-}
+#include "src/detective.h"
 
-/**
- * adicionarPista()
- * Função wrapper que registra a pista (chama inserirPista) e informa o jogador.
- */
-ClueNode *adicionarPista(ClueNode *root, const char *clue) {
-    if (!clue) return root;
-    printf("\n> Pista encontrada: \"%s\"\n", clue);
-    root = inserirPista(root, clue);
-    printf("Pista adicionada ao caderno do jogador.\n\n");
-    return root;
-}
-
-/**
- * inserirNaHash()
- * Insere uma associação pista -> suspeito na tabela hash.
- * Não insere duplicatas de chave (substitui se já existir).
- */
-unsigned int hash_func(const char *s) {
-    unsigned long h = 5381;
-    while (*s) h = ((h << 5) + h) + (unsigned char)(*s++);
-    return (unsigned int)(h % HASH_SIZE);
-}
-
-void inserirNaHash(HashEntry *table[], const char *pista, const char *suspeito) {
-    if (!pista || !suspeito) return;
-    unsigned int idx = hash_func(pista);
-    HashEntry *cur = table[idx];
-    while (cur) {
-        if (strcmp(cur->key, pista) == 0) {
-            // substitui o suspeito existente
-            free(cur->suspect);
-            cur->suspect = strdup_safe(suspeito);
-            return;
+/* ----------------------------- main ----------------------------- */
+int main(int argc, char **argv) {
+    // espectadores: --espectador <arquivo|fifo> (pode repetir)
+    // modo cooperativo: --coop <n> (2 a MAX_JOGADORES detetives)
+    // escolha do caso: --caso <id>
+    // diário de comandos: --diario <arquivo> (io_uring se disponível; --sem-uring usa write)
+    // jogo salvo: --carregar <arquivo>
+    // salvamento automático incremental: --autosave <arquivo>
+    // benchmarks: --bench <arquivo de resultados>
+    // estrutura das pistas no caderno: --caderno <bst|art|saltos> (= --backend caderno=...)
+    // backends das estruturas: --backend <família>=<nome> (pode repetir); --backends lista
+    // pré-carregamento das salas vizinhas: desativado com --sem-prefetch
+    // ranking de partidas resolvidas: --ranking <arquivo> (nome do jogador em $USER)
+    // conferência de diários em paralelo: --reproduzir <diário> (pode repetir)
+    // perfil por amostragem em pilhas dobradas: --perfil <arquivo>
+    // métricas no formato do Prometheus em socket Unix: --metricas <socket>
+    Transmissao tx = { .nEspectadores = 0 };
+    int nJogadores = 1;
+    const char *idCaso = CASOS[0].id;
+    const char *arquivoDiario = NULL, *arquivoJogo = NULL, *arquivoAutosave = NULL;
+    const char *arquivoBench = NULL, *arquivoRanking = NULL;
+    int usarPrefetch = 1;
+    const char **diariosReproduzir = malloc(argc * sizeof(char*));
+    int nReproduzir = 0;
+    if (!diariosReproduzir) { perror("malloc"); exit(EXIT_FAILURE); }
+    signal(SIGPIPE, SIG_IGN);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--espectador") == 0 && i + 1 < argc) {
+            inscreverEspectador(&tx, argv[++i]);
+        } else if (strcmp(argv[i], "--coop") == 0 && i + 1 < argc) {
+            nJogadores = atoi(argv[++i]);
+            if (nJogadores < 2 || nJogadores > MAX_JOGADORES) {
+                fprintf(stderr, "O modo cooperativo aceita de 2 a %d detetives.\n", MAX_JOGADORES);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--caso") == 0 && i + 1 < argc) {
+            idCaso = argv[++i];
+        } else if (strcmp(argv[i], "--diario") == 0 && i + 1 < argc) {
+            arquivoDiario = argv[++i];
+        } else if (strcmp(argv[i], "--carregar") == 0 && i + 1 < argc) {
+            arquivoJogo = argv[++i];
+        } else if (strcmp(argv[i], "--autosave") == 0 && i + 1 < argc) {
+            arquivoAutosave = argv[++i];
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            arquivoBench = argv[++i];
+        } else if (strcmp(argv[i], "--sem-uring") == 0) {
+            usarIoUring = 0;
+        } else if (strcmp(argv[i], "--sem-prefetch") == 0) {
+            usarPrefetch = 0;
+        } else if (strcmp(argv[i], "--ranking") == 0 && i + 1 < argc) {
+            arquivoRanking = argv[++i];
+        } else if (strcmp(argv[i], "--perfil") == 0 && i + 1 < argc) {
+            if (iniciarPerfil(argv[++i]) < 0) return EXIT_FAILURE;
+        } else if (strcmp(argv[i], "--metricas") == 0 && i + 1 < argc) {
+            if (iniciarMetricas(argv[++i]) < 0) return EXIT_FAILURE;
+        } else if (strcmp(argv[i], "--reproduzir") == 0 && i + 1 < argc) {
+            diariosReproduzir[nReproduzir++] = argv[++i];
+        } else if (strcmp(argv[i], "--caderno") == 0 && i + 1 < argc) {
+            char especificacao[64];
+            snprintf(especificacao, sizeof(especificacao), "caderno=%s", argv[++i]);
+            if (selecionarBackend(especificacao) < 0) return EXIT_FAILURE;
+        } else if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            if (selecionarBackend(argv[++i]) < 0) return EXIT_FAILURE;
+        } else if (strcmp(argv[i], "--backends") == 0) {
+            listarBackends(stdout);
+            free(diariosReproduzir);
+            return EXIT_SUCCESS;
+        } else {
+            fprintf(stderr, "Uso: %s [--espectador <arquivo|fifo>]... [--coop <n>] [--caso <id>]\n"
+                            "       [--diario <arquivo>] [--carregar <arquivo>] [--autosave <arquivo>]\n"
+                            "       [--bench <arquivo>] [--caderno <bst|art|saltos>] [--sem-uring]\n"
+                            "       [--sem-prefetch] [--ranking <arquivo>] [--reproduzir <diário>]...\n"
+                            "       [--perfil <arquivo>] [--metricas <socket>]\n"
+                            "       [--backend <família>=<nome>]... [--backends]\n", argv[0]);
+            return EXIT_FAILURE;
         }
-        cur = cur->next;
     }
-    // novo entry
-    HashEntry *e = (HashEntry*)malloc(sizeof(HashEntry));
-    if (!e) { perror("malloc"); exit(EXIT_FAILURE); }
-    e->key = strdup_safe(pista);
-    e->suspect = strdup_safe(suspeito);
-    e->next = table[idx];
-    table[idx] = e;
-}
 
-/**
- * encontrarSuspeito()
- * Consulta a tabela hash para encontrar o suspeito associado a uma pista.
- * Retorna NULL se não encontrado.
- */
-char *encontrarSuspeito(HashEntry *table[], const char *pista) {
-    if (!pista) return NULL;
-    unsigned int idx = hash_func(pista);
-    HashEntry *cur = table[idx];
-    while (cur) {
-        if (strcmp(cur->key, pista) == 0) return cur->suspect;
-        cur = cur->next;
+    // preparar
+    PacoteCasos *pacote = carregarPacote(CASOS, N_CASOS);
+    if (arquivoBench) {
+        free(diariosReproduzir);
+        int r = executarBenchmarks(pacote, arquivoBench);
+        liberarPacote(pacote);
+        return r == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
     }
-    return NULL;
-}
-
-/**
- * explorarSalas()
- * Navega pela árvore de cômodos de forma interativa.
- * Ao visitar um cômodo, identifica a pista associada (se houver) e a coleta automaticamente.
- */
-void explorarSalas(Room *root, ClueNode **collected, HashEntry *table[]) {
-    Room *atual = root;
-    char input[MAX_INPUT];
-
-    printf("\n--- Início da exploração da mansão ---\n");
-    while (atual) {
-        printf("Você está na sala: %s\n", atual->name);
-        // identificar pista associada
-        // lógica de pistas: função getClueForRoom
-        const char *clue = NULL;
-        // Definimos pistas estáticas por nome
-        // (a lógica poderia ser mais complexa, mas está hard-coded conforme requisição)
-        if (strcmp(atual->name, "Entrada") == 0) clue = "Pegadas lamacentas";
-        else if (strcmp(atual->name, "Salão") == 0) clue = "Vidro quebrado";
-        else if (strcmp(atual->name, "Cozinha") == 0) clue = "Faca com impressões";
-        else if (strcmp(atual->name, "Biblioteca") == 0) clue = "Livro deslocado";
-        else if (strcmp(atual->name, "Escritório") == 0) clue = "Carta rasgada";
-        else if (strcmp(atual->name, "Quarto") == 0) clue = "Frascos vazios";
-        else if (strcmp(atual->name, "Varanda") == 0) clue = "Fibra vermelha";
-        else if (strcmp(atual->name, "Sótão") == 0) clue = "Marcas de arraste";
-        else if (strcmp(atual->name, "Porão") == 0) clue = "Pegada pequena";
-        else clue = NULL; // sala sem pista específica
-
-        if (clue) *collected = adicionarPista(*collected, clue);
-        else printf("Não há pistas aparentes nesta sala.\n\n");
-
-        // controle de navegação
-        printf("Escolha: (e) esquerdo, (d) direito, (s) sair da exploração\n");
-        printf("> ");
-        if (!fgets(input, sizeof(input), stdin)) break;
-        trim_newline(input);
-        if (strlen(input) == 0) continue;
-        char c = input[0];
-        if (c == 'e' || c == 'E') {
-            if (atual->left) atual = atual->left;
-            else printf("Não há sala à esquerda.\n\n");
-        } else if (c == 'd' || c == 'D') {
-            if (atual->right) atual = atual->right;
-            else printf("Não há sala à direita.\n\n");
-        } else if (c == 's' || c == 'S') {
-            printf("Saindo da exploração...\n");
-            break;
+    if (nReproduzir > 0) {
+        int falhas = executarReproducoes(pacote, diariosReproduzir, nReproduzir);
+        free(diariosReproduzir);
+        liberarPacote(pacote);
+        return falhas == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    free(diariosReproduzir);
+    Sessao *sessao = NULL;
+    if (arquivoJogo) {
+        sessao = carregarJogo(pacote, arquivoJogo);
+    } else {
+        Caso *escolhido = buscarCaso(pacote, idCaso);
+        if (escolhido) {
+            sessao = criarSessao(entradaPropriedade(escolhido->propriedade));
+            sessao->caso = escolhido;
         } else {
-            printf("Opção inválida. Use e, d ou s.\n\n");
+            fprintf(stderr, "Caso desconhecido: %s\n", idCaso);
         }
     }
-    printf("--- Fim da exploração ---\n\n");
-}
-
-/**
- * verificarSuspeitoFinal()
- * Conduz a fase de julgamento final: percorre as pistas coletadas e verifica
- * quantas apontam para o suspeito acusado. Exibe o veredito com base na regra
- * de pelo menos duas pistas apontando para o mesmo suspeito.
- */
-
-// Helper: percorre BST em-ordem e conta quantas pistas correspondem ao suspeito
-int count_clues_for_suspect(ClueNode *root, HashEntry *table[], const char *suspect) {
-    if (!root) return 0;
-    int cnt = 0;
-    cnt += count_clues_for_suspect(root->left, table, suspect);
-    char *s = encontrarSuspeito(table, root->clue);
-    if (s && strcmp(s, suspect) == 0) cnt++;
-    cnt += count_clues_for_suspect(root->right, table, suspect);
-    return cnt;
-}
-
-void listarPistas(ClueNode *root) {
-    if (!root) return;
-    listarPistas(root->left);
-    printf(" - %s\n", root->clue);
-    listarPistas(root->right);
-}
-
-void verificarSuspeitoFinal(ClueNode *collected, HashEntry *table[]) {
-    if (!collected) {
-        printf("Nenhuma pista foi coletada. Não é possível acusar com fundamento.\n");
-        return;
+    if (!sessao) {
+        liberarPacote(pacote);
+        return EXIT_FAILURE;
     }
-    printf("Pistas coletadas:\n");
-    listarPistas(collected);
-
-    char accused[MAX_INPUT];
-    printf("\nDigite o nome do suspeito que você deseja acusar: ");
-    if (!fgets(accused, sizeof(accused), stdin)) return;
-    trim_newline(accused);
-    if (strlen(accused) == 0) {
-        printf("Nenhum suspeito informado. Encerrando julgamento.\n");
-        return;
+    Caso *caso = sessao->caso;
+    printf("Caso: %s\n", caso->def->titulo);
+    Room *mansao = sessao->mansao;
+    TabelaPistas *table = &caso->tabela;
+    IndiceProcedencia *proc = &caso->procedencia;
+    if (arquivoDiario && nJogadores == 1) {
+        // o modo cooperativo não grava comandos no diário
+        sessao->diario = abrirDiario(arquivoDiario);
+        registrarControleDiario(sessao->diario, arquivoJogo ? DIARIO_RETOMADO : DIARIO_CASO, sessao);
     }
-    // Normalizar a entrada (case-insensitive matching) - assumimos nomes na tabela com mesma capitalização
-    // Contamos pistas que apontam para esse suspeito
-    int count = count_clues_for_suspect(collected, table, accused);
-    printf("\nVocê acusou: %s\n", accused);
-    printf("Pistas que apontam para %s: %d\n", accused, count);
+    if (arquivoAutosave) sessao->autosave = criarAutoSalvamento(arquivoAutosave, INTERVALO_AUTOSAVE);
+    if (usarPrefetch) sessao->prefetcher = iniciarPrefetcher(&caso->descricoes);
 
-    if (count >= 2) {
-        printf("DESFECHO: Acusação válida! Há provas suficientes para sustentar o caso.\n");
+    // explorar salas
+    double inicio = agoraNs();
+    int movimentos = 0;
+    if (nJogadores > 1) {
+        // no modo cooperativo o caderno da equipe substitui o da sessão
+        EstadoCoop coop;
+        iniciarCoop(&coop, mansao, nJogadores);
+        explorarCoop(&coop, table, proc, &tx);
+        encerrarCoop(&coop);
+        liberarCaderno(sessao->caderno);
+        sessao->caderno = coop.caderno;
+        for (int j = 0; j < nJogadores; j++) movimentos += coop.movimentos[j];
     } else {
-        printf("DESFECHO: Acusação fraca. Pelo menos 2 pistas são necessárias para condenar.\n");
-    }
-}
-
-/* ----------------------------- Construção do cenário ----------------------------- */
-
-// Constrói a mansão (árvore de cômodos) - exemplo balanceado simples
-Room *construirMansao() {
-    Room *rEntrada = criarSala("Entrada");
-    Room *rSala = criarSala("Salão");
-    Room *rCozinha = criarSala("Cozinha");
-    Room *rBiblioteca = criarSala("Biblioteca");
-    Room *rEscritorio = criarSala("Escritório");
-    Room *rQuarto = criarSala("Quarto");
-    Room *rVaranda = criarSala("Varanda");
-    Room *rSotao = criarSala("Sótão");
-    Room *rPorão = criarSala("Porão");
-
-    // montar conexões (árvore binária)
-    rEntrada->left = rSala;    rEntrada->right = rCozinha;
-    rSala->left = rBiblioteca; rSala->right = rEscritorio;
-    rCozinha->left = rQuarto;  rCozinha->right = rVaranda;
-    rBiblioteca->left = rSotao; // para tornar a árvore mais extensa
-    rEscritorio->right = rPorão;
-
-    return rEntrada;
-}
-
-// Inicializa a tabela hash com associações pista -> suspeito
-void popularTabelaHash(HashEntry *table[]) {
-    // limpar
-    for (int i=0;i<HASH_SIZE;i++) table[i] = NULL;
-
-    inserirNaHash(table, "Pegadas lamacentas", "Sr. Verde");
-    inserirNaHash(table, "Vidro quebrado", "Sra. Rosa");
-    inserirNaHash(table, "Faca com impressões", "Sr. Preto");
-    inserirNaHash(table, "Livro deslocado", "Sra. Rosa");
-    inserirNaHash(table, "Carta rasgada", "Sr. Preto");
-    inserirNaHash(table, "Frascos vazios", "Dr. Azul");
-    inserirNaHash(table, "Fibra vermelha", "Sra. Rosa");
-    inserirNaHash(table, "Marcas de arraste", "Sr. Verde");
-    inserirNaHash(table, "Pegada pequena", "Sra. Rosa");
-}
-
-/* ----------------------------- Limpeza de memória ----------------------------- */
-
-void freeRooms(Room *r) {
-    if (!r) return;
-    freeRooms(r->left);
-    freeRooms(r->right);
-    free(r->name);
-    free(r);
-}
-
-void freeClues(ClueNode *n) {
-    if (!n) return;
-    freeClues(n->left);
-    freeClues(n->right);
-    free(n->clue);
-    free(n);
-}
-
-void freeHash(HashEntry *table[]) {
-    for (int i=0;i<HASH_SIZE;i++) {
-        HashEntry *cur = table[i];
-        while (cur) {
-            HashEntry *tmp = cur;
-            cur = cur->next;
-            free(tmp->key);
-            free(tmp->suspect);
-            free(tmp);
-        }
-        table[i] = NULL;
+        explorarSalas(sessao, table, proc, &tx);
+        registrarControleDiario(sessao->diario, DIARIO_FIM, sessao);
+        movimentos = sessao->movimento;
     }
-}
-
-/* ----------------------------- main ----------------------------- */
-int main(void) {
-    // preparar
-    Room *mansao = construirMansao();
-    HashEntry *table[HASH_SIZE];
-    popularTabelaHash(table);
-
-    ClueNode *collected = NULL;
-
-    // explorar salas
-    explorarSalas(mansao, &collected, table);
+    encerrarTransmissao(&tx);
 
     // fase de julgamento
-    verificarSuspeitoFinal(collected, table);
+    if (verificarSuspeitoFinal(sessao->caderno, table) && arquivoRanking) {
+        double ms = (agoraNs() - inicio) / 1e6;
+        const char *nome = getenv("USER");
+        registrarResultadoNoRanking(arquivoRanking, nome && *nome ? nome : "detetive",
+                                    ms < UINT32_MAX ? (uint32_t)ms : UINT32_MAX - 1,
+                                    (uint32_t)(sessao->caderno->total * 1000L / (movimentos > 0 ? movimentos : 1)));
+    }
 
     // limpeza
-    freeRooms(mansao);
-    freeClues(collected);
-    freeHash(table);
+    fecharDiario(sessao->diario);
+    encerrarAutoSalvamento(sessao->autosave);
+    encerrarPrefetcher(sessao->prefetcher);
+    liberarSessao(sessao);
+    liberarPacote(pacote);
+    liberarLeitor(&entrada);
 
     printf("\nObrigado por jogar Detective Quest!\n");
     return 0;